@@ -0,0 +1,26 @@
+// AllocCounter: replacement global operator new/delete, see alloc_counter.h.
+
+#include "alloc_counter.h"
+
+void* operator new( std::size_t size )
+{
+    if( void* ptr = AllocCounter::CountedNew( size ) )
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size )
+{
+    if( void* ptr = AllocCounter::CountedNew( size ) )
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept         { return AllocCounter::CountedNew( size ); }
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept       { return AllocCounter::CountedNew( size ); }
+void  operator delete( void* ptr ) noexcept                                     { free( ptr ); }
+void  operator delete[]( void* ptr ) noexcept                                   { free( ptr ); }
+void  operator delete( void* ptr, std::size_t ) noexcept                        { free( ptr ); }
+void  operator delete[]( void* ptr, std::size_t ) noexcept                      { free( ptr ); }
+void  operator delete( void* ptr, const std::nothrow_t& ) noexcept              { free( ptr ); }
+void  operator delete[]( void* ptr, const std::nothrow_t& ) noexcept            { free( ptr ); }
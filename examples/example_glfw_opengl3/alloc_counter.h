@@ -0,0 +1,76 @@
+// AllocCounter: counts heap allocations made through global operator new and through Dear ImGui's allocator.
+// Used to check that a steady-state inspector frame does not allocate.
+//
+// - Call AllocCounter::InstallImGuiAllocator() before ImGui::CreateContext().
+// - Call AllocCounter::BeginFrame() at the start of a frame, AllocCounter::GetFrameStats() at the end.
+// - Counts are per thread: both calls see the allocations of the calling thread only, so worker threads (simulation,
+//   thread pool, services) do not show up in the UI thread's frame.
+// - Link alloc_counter.cpp into the executable: it provides the replacement global operator new/delete (over-aligned
+//   allocations are not counted). They live in a translation unit of their own so that the compiler never inlines
+//   them into callers and never pairs a new-expression with the free() inside.
+
+#pragma once
+
+#include "imgui.h"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace AllocCounter
+{
+    struct FrameStats
+    {
+        std::size_t newCount;       // global operator new / new[] calls
+        std::size_t newBytes;
+        std::size_t imguiCount;     // ImGui::MemAlloc() calls
+        std::size_t imguiBytes;
+
+        std::size_t TotalCount() const { return newCount + imguiCount; }
+    };
+
+    inline thread_local std::size_t t_newCount = 0;
+    inline thread_local std::size_t t_newBytes = 0;
+    inline thread_local std::size_t t_imguiCount = 0;
+    inline thread_local std::size_t t_imguiBytes = 0;
+
+    // Resets the calling thread's counters.
+    inline void BeginFrame()
+    {
+        t_newCount = 0;
+        t_newBytes = 0;
+        t_imguiCount = 0;
+        t_imguiBytes = 0;
+    }
+
+    // Allocations made by the calling thread since its last BeginFrame().
+    inline FrameStats GetFrameStats()
+    {
+        return FrameStats{ t_newCount, t_newBytes, t_imguiCount, t_imguiBytes };
+    }
+
+    inline void* CountingImGuiAlloc( size_t size, void* user_data )
+    {
+        IM_UNUSED( user_data );
+        t_imguiCount++;
+        t_imguiBytes += size;
+        return malloc( size );
+    }
+
+    inline void CountingImGuiFree( void* ptr, void* user_data )
+    {
+        IM_UNUSED( user_data );
+        free( ptr );
+    }
+
+    inline void InstallImGuiAllocator()
+    {
+        ImGui::SetAllocatorFunctions( CountingImGuiAlloc, CountingImGuiFree, nullptr );
+    }
+
+    inline void* CountedNew( std::size_t size ) noexcept
+    {
+        t_newCount++;
+        t_newBytes += size;
+        return malloc( size ? size : 1 );
+    }
+} // namespace AllocCounter
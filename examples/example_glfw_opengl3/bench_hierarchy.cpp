@@ -0,0 +1,229 @@
+// Headless benchmark for the ReflectiveJson inspector over synthetic reflected hierarchies.
+// Each object is a chain of nested reflected structs: 'depth' levels below the root, each level with 'fields' leaf
+// members (int, float, bool and ImVec4, in turn) plus the next level. Every frame runs NewFrame + DrawImGui over all
+// objects + Render in a Dear ImGui context without any platform/renderer backend.
+//
+// Reported per configuration: time per frame and per leaf field, heap allocations per frame (Dear ImGui and global
+// operator new), and the size of the resulting draw data (vertices, indices, draw commands).
+//
+// Usage: bench_hierarchy [depth 0-4] [fields 1|2|4|8|16] [objects] [frames]
+//        bench_hierarchy                  runs the standard grid of configurations, one line each
+// Exits with a non-zero code if a steady-state frame allocates.
+
+#include "imgui.h"
+#include "alloc_counter.h"
+#include "reflective_json.h"
+#include <array>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ---------- Synthetic types ----------
+#define SYNTH_LEAF_MEMBERS(N) int i##N = N; float f##N = 0.5f; bool b##N = (N & 1) != 0; ImVec4 c##N{ 0.2f, 0.4f, 0.6f, 1.0f };
+
+// Descriptors of the 16 leaf members of C, in declaration order.
+template<typename C>
+constexpr auto SynthLeafDescs()
+{
+    using ReflectiveJson::makeField;
+    return std::make_tuple(
+        makeField( "i0", &C::i0, 0, 100 ), makeField( "f0", &C::f0, 0.0, 1.0 ), makeField( "b0", &C::b0 ), makeField( "c0", &C::c0 ),
+        makeField( "i1", &C::i1, 0, 100 ), makeField( "f1", &C::f1, 0.0, 1.0 ), makeField( "b1", &C::b1 ), makeField( "c1", &C::c1 ),
+        makeField( "i2", &C::i2, 0, 100 ), makeField( "f2", &C::f2, 0.0, 1.0 ), makeField( "b2", &C::b2 ), makeField( "c2", &C::c2 ),
+        makeField( "i3", &C::i3, 0, 100 ), makeField( "f3", &C::f3, 0.0, 1.0 ), makeField( "b3", &C::b3 ), makeField( "c3", &C::c3 ) );
+}
+
+// The first 'Width' leaf descriptors of C.
+template<typename C, std::size_t... I>
+constexpr auto SynthTakeLeaves( std::index_sequence<I...> )
+{
+    constexpr auto all = SynthLeafDescs<C>();
+    return std::make_tuple( std::get<I>( all )... );
+}
+
+template<int Depth, int Width>
+struct SynthNode
+{
+    SYNTH_LEAF_MEMBERS( 0 ) SYNTH_LEAF_MEMBERS( 1 ) SYNTH_LEAF_MEMBERS( 2 ) SYNTH_LEAF_MEMBERS( 3 )
+    SynthNode<Depth - 1, Width> child;
+
+    using RttiClass = SynthNode;
+    static constexpr auto fieldDescs()
+    {
+        return std::tuple_cat( SynthTakeLeaves<SynthNode>( std::make_index_sequence<Width>{} ),
+            std::make_tuple( ReflectiveJson::makeField( "child", &SynthNode::child ) ) );
+    }
+    static const std::vector<ReflectiveJson::FieldInfo<SynthNode>>& getFields()
+    {
+        static const std::vector<ReflectiveJson::FieldInfo<SynthNode>> fields = ReflectiveJson::makeFieldTable<SynthNode>();
+        return fields;
+    }
+};
+
+template<int Width>
+struct SynthNode<0, Width>
+{
+    SYNTH_LEAF_MEMBERS( 0 ) SYNTH_LEAF_MEMBERS( 1 ) SYNTH_LEAF_MEMBERS( 2 ) SYNTH_LEAF_MEMBERS( 3 )
+
+    using RttiClass = SynthNode;
+    static constexpr auto fieldDescs()
+    {
+        return SynthTakeLeaves<SynthNode>( std::make_index_sequence<Width>{} );
+    }
+    static const std::vector<ReflectiveJson::FieldInfo<SynthNode>>& getFields()
+    {
+        static const std::vector<ReflectiveJson::FieldInfo<SynthNode>> fields = ReflectiveJson::makeFieldTable<SynthNode>();
+        return fields;
+    }
+};
+
+// ---------- Frames ----------
+struct BenchResult
+{
+    double nsPerFrame;
+    double allocsPerFrame;
+    int vertices;
+    int indices;
+    int drawCommands;
+};
+
+template<typename T>
+static void RunFrame( std::vector<T>& objects )
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos( ImVec2( 0, 0 ) );
+    ImGui::SetNextWindowSize( io.DisplaySize );
+    ImGui::Begin( "Inspector" );
+    for( T& object : objects )
+        ReflectiveJson::DrawImGui( object );
+    ImGui::End();
+    ImGui::Render();
+}
+
+template<int Depth, int Width>
+static BenchResult TimeConfig( int objectCount, int frames )
+{
+    using Node = SynthNode<Depth, Width>;
+    std::vector<Node> objects( objectCount );
+
+    // Warm up: open headers, build the getFields() tables, fill ImGui's internal pools.
+    for( int i = 0; i < 10; i++ )
+        RunFrame( objects );
+
+    std::size_t allocs = 0;
+    double ns = 0.0;
+    for( int i = 0; i < frames; i++ )
+    {
+        AllocCounter::BeginFrame();
+        auto start = std::chrono::steady_clock::now();
+        RunFrame( objects );
+        auto end = std::chrono::steady_clock::now();
+        allocs += AllocCounter::GetFrameStats().TotalCount();
+        ns += std::chrono::duration<double, std::nano>( end - start ).count();
+    }
+
+    // Draw data of the last frame (identical from frame to frame)
+    BenchResult result{ ns / frames, ( double )allocs / frames, 0, 0, 0 };
+    const ImDrawData* drawData = ImGui::GetDrawData();
+    result.vertices = drawData->TotalVtxCount;
+    result.indices = drawData->TotalIdxCount;
+    for( const ImDrawList* list : drawData->CmdLists )
+        result.drawCommands += list->CmdBuffer.Size;
+    return result;
+}
+
+// ---------- Configurations ----------
+static const int MaxDepth = 4;
+static const int Widths[] = { 1, 2, 4, 8, 16 };
+static const int WidthCount = IM_ARRAYSIZE( Widths );
+
+typedef BenchResult (*BenchConfigFunc)( int objectCount, int frames );
+
+template<int Depth, std::size_t... W>
+static constexpr std::array<BenchConfigFunc, sizeof...(W)> MakeDepthRow( std::index_sequence<W...> )
+{
+    return { &TimeConfig<Depth, 1 << W>... };
+}
+
+template<std::size_t... D>
+static constexpr std::array<std::array<BenchConfigFunc, WidthCount>, sizeof...(D)> MakeConfigTable( std::index_sequence<D...> )
+{
+    return { MakeDepthRow<( int )D>( std::make_index_sequence<WidthCount>{} )... };
+}
+
+static const std::array<std::array<BenchConfigFunc, WidthCount>, MaxDepth + 1> ConfigTable = MakeConfigTable( std::make_index_sequence<MaxDepth + 1>{} );
+
+static int WidthIndex( int fields )
+{
+    for( int i = 0; i < WidthCount; i++ )
+        if( Widths[ i ] == fields )
+            return i;
+    return -1;
+}
+
+static void PrintHeader()
+{
+    printf( "%6s %6s %8s %12s %12s %10s %12s %10s %10s %10s\n", "depth", "fields", "objects", "fields/frame",
+        "us/frame", "ns/field", "allocs/frame", "vertices", "indices", "draw cmds" );
+}
+
+// Runs one configuration and prints its line. Returns false if a steady-state frame allocated.
+static bool RunConfig( int depth, int fields, int objectCount, int frames )
+{
+    ReflectiveJson::nestedHeaderFlags = ImGuiTreeNodeFlags_DefaultOpen;   // submit every field, not just the headers
+    const BenchResult r = ConfigTable[ depth ][ WidthIndex( fields ) ]( objectCount, frames );
+    const int fieldsPerFrame = objectCount * fields * (depth + 1);
+    printf( "%6d %6d %8d %12d %12.1f %10.2f %12.1f %10d %10d %10d\n", depth, fields, objectCount, fieldsPerFrame,
+        r.nsPerFrame / 1000.0, r.nsPerFrame / fieldsPerFrame, r.allocsPerFrame, r.vertices, r.indices, r.drawCommands );
+    return r.allocsPerFrame == 0.0;
+}
+
+int main( int argc, char** argv )
+{
+    IMGUI_CHECKVERSION();
+    AllocCounter::InstallImGuiAllocator();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2( 1920, 1080 );
+    io.IniFilename = nullptr;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+
+    bool ok = true;
+    if( argc > 1 )
+    {
+        const int depth = atoi( argv[ 1 ] );
+        const int fields = argc > 2 ? atoi( argv[ 2 ] ) : 4;
+        const int objectCount = argc > 3 ? atoi( argv[ 3 ] ) : 1000;
+        const int frames = argc > 4 ? atoi( argv[ 4 ] ) : 200;
+        if( depth < 0 || depth > MaxDepth || WidthIndex( fields ) < 0 || objectCount <= 0 || frames <= 0 )
+        {
+            fprintf( stderr, "usage: bench_hierarchy [depth 0-%d] [fields 1|2|4|8|16] [objects] [frames]\n", MaxDepth );
+            ImGui::DestroyContext();
+            return 2;
+        }
+        PrintHeader();
+        ok = RunConfig( depth, fields, objectCount, frames );
+    }
+    else
+    {
+        // Standard grid: keep it stable so results can be compared across releases.
+        PrintHeader();
+        for( int depth : { 0, 2, 4 } )
+            for( int fields : { 4, 16 } )
+                for( int objectCount : { 100, 1000 } )
+                    ok &= RunConfig( depth, fields, objectCount, 100 );
+    }
+
+    ImGui::DestroyContext();
+
+    if( !ok )
+    {
+        fprintf( stderr, "FAILED: a steady-state DrawImGui() frame allocated\n" );
+        return 1;
+    }
+    return 0;
+}
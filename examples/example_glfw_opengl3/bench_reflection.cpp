@@ -0,0 +1,123 @@
+// Headless benchmark for the ReflectiveJson inspector.
+// Creates a Dear ImGui context without any platform/renderer backend and times full frames
+// (NewFrame + DrawImGui over N objects + Render) for each field-walking path.
+//
+// Usage: bench_reflection [objects] [frames]
+// Exits with a non-zero code if a steady-state DrawImGui() frame allocates.
+
+#include "imgui.h"
+#include "alloc_counter.h"
+#include "reflective_json.h"
+#include "reflected_types.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef void (*BenchDrawFunc)( std::vector<Material>& materials );
+
+static void DrawStatic( std::vector<Material>& materials )
+{
+    for( Material& material : materials )
+        ReflectiveJson::DrawImGui( material );
+}
+
+static void DrawTable( std::vector<Material>& materials )
+{
+    for( Material& material : materials )
+        ReflectiveJson::DrawImGuiTable( material );
+}
+
+static void RunFrame( std::vector<Material>& materials, BenchDrawFunc draw )
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos( ImVec2( 0, 0 ) );
+    ImGui::SetNextWindowSize( io.DisplaySize );
+    ImGui::Begin( "Inspector" );
+    draw( materials );
+    ImGui::End();
+    ImGui::Render();
+}
+
+struct BenchResult
+{
+    double nsPerFrame;
+    double allocsPerFrame;
+};
+
+static BenchResult TimeFrames( std::vector<Material>& materials, BenchDrawFunc draw, int frames )
+{
+    // Warm up: open headers, build the getFields() tables, fill ImGui's internal pools.
+    for( int i = 0; i < 10; i++ )
+        RunFrame( materials, draw );
+
+    std::size_t allocs = 0;
+    double ns = 0.0;
+    for( int i = 0; i < frames; i++ )
+    {
+        AllocCounter::BeginFrame();
+        auto start = std::chrono::steady_clock::now();
+        RunFrame( materials, draw );
+        auto end = std::chrono::steady_clock::now();
+        allocs += AllocCounter::GetFrameStats().TotalCount();
+        ns += std::chrono::duration<double, std::nano>( end - start ).count();
+    }
+    return BenchResult{ ns / frames, ( double )allocs / frames };
+}
+
+// Number of leaf fields DrawImGui visits for one object (nested reflected objects are expanded).
+template<typename T>
+static int CountLeafFields()
+{
+    int count = 0;
+    ReflectiveJson::forEachField<T>( [&]( const auto& desc )
+    {
+        using M = typename std::decay_t<decltype(desc)>::Member;
+        if constexpr( ReflectiveJson::has_getFields_v<M> )
+            count += CountLeafFields<M>();
+        else
+            count += 1;
+    } );
+    return count;
+}
+
+int main( int argc, char** argv )
+{
+    const int objectCount = argc > 1 ? atoi( argv[ 1 ] ) : 1000;
+    const int frameCount = argc > 2 ? atoi( argv[ 2 ] ) : 200;
+
+    IMGUI_CHECKVERSION();
+    AllocCounter::InstallImGuiAllocator();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2( 1920, 1080 );
+    io.IniFilename = nullptr;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+
+    std::vector<Material> materials( objectCount );
+
+    // Nested headers are closed by default: open them all so every field is actually submitted.
+    ReflectiveJson::nestedHeaderFlags = ImGuiTreeNodeFlags_DefaultOpen;
+
+    const int fieldsPerFrame = objectCount * CountLeafFields<Material>();
+    const BenchResult table = TimeFrames( materials, DrawTable, frameCount );
+    const BenchResult fold = TimeFrames( materials, DrawStatic, frameCount );
+
+    printf( "objects: %d, frames: %d, fields/frame: %d\n", objectCount, frameCount, fieldsPerFrame );
+    printf( "%-28s %12s %12s %12s\n", "path", "us/frame", "ns/field", "allocs/frame" );
+    printf( "%-28s %12.1f %12.1f %12.1f\n", "getFields() std::function", table.nsPerFrame / 1000.0, table.nsPerFrame / fieldsPerFrame, table.allocsPerFrame );
+    printf( "%-28s %12.1f %12.1f %12.1f\n", "fieldDescs() fold", fold.nsPerFrame / 1000.0, fold.nsPerFrame / fieldsPerFrame, fold.allocsPerFrame );
+    printf( "speedup: %.2fx\n", table.nsPerFrame / fold.nsPerFrame );
+
+    ImGui::DestroyContext();
+
+    if( fold.allocsPerFrame != 0.0 )
+    {
+        fprintf( stderr, "FAILED: steady-state DrawImGui() frame allocated %.1f times\n", fold.allocsPerFrame );
+        return 1;
+    }
+    return 0;
+}
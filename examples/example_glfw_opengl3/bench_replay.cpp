@@ -0,0 +1,195 @@
+// Headless replay of recorded input sessions (see input_recorder.h).
+// Draws the windows of the example application through ExampleApp::DrawReflectedWindows() (example_app.h, the
+// function main.cpp draws them with) without any platform/renderer backend, feeds the recorded events frame by frame
+// with a fixed DeltaTime and reports per-frame CPU time, vertices, indices and heap allocations. The same log gives
+// the same frames on every run, so two builds can be compared on a real session rather than on a synthetic sweep.
+//
+// Usage: bench_replay [session.inputlog] [deltaTime]     record the log with the "Record input" button of the example
+//        bench_replay                                    replays a built-in scripted session (headers, drag, search)
+// Prints one line per frame, then the totals and the slowest frames.
+
+#include "imgui.h"
+#include "alloc_counter.h"
+#include "input_recorder.h"
+#include "example_app.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ---------- Scene ----------
+// The light simulation runs on a thread in main.cpp; here it steps once per frame, so every run shows the same hues.
+static void DrawScene( void* user )
+{
+    ExampleApp::Scene& scene = *static_cast< ExampleApp::Scene* >(user);
+    scene.stepLight();
+    ExampleApp::DrawReflectedWindows( scene );
+}
+
+// ---------- Built-in session ----------
+// Recorded through the real Recorder: the events are queued the way a backend would, one batch per frame.
+struct ScriptStep
+{
+    int frames;                     // idle frames after the events
+    void ( *events )(ImGuiIO& io, int step);
+    int repeat;
+};
+
+static void ClickDebugRow( ImGuiIO& io, int step )
+{
+    const float y = 40.0f + 23.0f * ( float )step;
+    io.AddMousePosEvent( 30.0f, y );
+    io.AddMouseButtonEvent( 0, true );
+    io.AddMouseButtonEvent( 0, false );
+}
+
+static void DragInDebug( ImGuiIO& io, int step )
+{
+    if( step == 0 )
+    {
+        io.AddMousePosEvent( 300.0f, 63.0f );
+        io.AddMouseButtonEvent( 0, true );
+    }
+    io.AddMousePosEvent( 300.0f + 4.0f * ( float )step, 63.0f );
+}
+
+static void ReleaseMouse( ImGuiIO& io, int )
+{
+    io.AddMouseButtonEvent( 0, false );
+}
+
+static void ScrollMaterials( ImGuiIO& io, int )
+{
+    io.AddMousePosEvent( 900.0f, 600.0f );
+    io.AddMouseWheelEvent( 0.0f, -3.0f );
+}
+
+static void ClickMaterialSearch( ImGuiIO& io, int )
+{
+    io.AddMousePosEvent( 900.0f, 52.0f );
+    io.AddMouseButtonEvent( 0, true );
+    io.AddMouseButtonEvent( 0, false );
+}
+
+static void TypeSearch( ImGuiIO& io, int step )
+{
+    static const char text[] = "stats";
+    io.AddInputCharacter( ( unsigned )text[ step ] );
+}
+
+static InputRecorder::Log RecordScriptedSession( ExampleApp::Scene& scene )
+{
+    static const ScriptStep script[] =
+    {
+        { 2, ClickDebugRow, 12 },
+        { 0, DragInDebug, 30 },
+        { 2, ReleaseMouse, 1 },
+        { 0, ScrollMaterials, 30 },
+        { 2, ClickMaterialSearch, 1 },
+        { 1, TypeSearch, 5 },
+        { 30, ScrollMaterials, 10 },
+    };
+    ImGuiIO& io = ImGui::GetIO();
+    InputRecorder::Recorder recorder;
+    recorder.start();
+    for( const ScriptStep& step : script )
+        for( int i = 0; i < step.repeat; i++ )
+            for( int frame = 0; frame <= step.frames; frame++ )
+            {
+                if( frame == 0 )
+                    step.events( io, i );
+                recorder.captureFrame();
+                io.DeltaTime = 1.0f / 60.0f;
+                ImGui::NewFrame();
+                DrawScene( &scene );
+                ImGui::Render();
+            }
+    recorder.stop();
+    return recorder.log();
+}
+
+// Windows at fixed places, so the scripted coordinates hit the same widgets on every run.
+static const char ScriptedIni[] =
+    "[Window][Debug##Default]\nPos=0,0\nSize=600,1000\n"
+    "[Window][Materials]\nPos=620,0\nSize=600,1000\n"
+    "[Window][Lights]\nPos=1240,0\nSize=600,500\n"
+    "[Window][Selected lights]\nPos=1240,520\nSize=600,300\n"
+    "[Window][Remote lights]\nPos=1240,840\nSize=290,230\n"
+    "[Window][Scene file]\nPos=1550,840\nSize=290,230\n"
+    "[Window][Hello, world!]\nPos=0,1010\nSize=1220,60\n";
+
+int main( int argc, char** argv )
+{
+    IMGUI_CHECKVERSION();
+    AllocCounter::InstallImGuiAllocator();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    const float deltaTime = argc > 2 ? ( float )atof( argv[ 2 ] ) : 1.0f / 60.0f;
+
+    InputRecorder::Log log;
+    std::string error;
+    if( argc > 1 && !InputRecorder::LoadLog( log, argv[ 1 ], &error ) )
+    {
+        fprintf( stderr, "bench_replay: %s\n", error.c_str() );
+        ImGui::DestroyContext();
+        return 2;
+    }
+    if( argc > 1 && !log.fontPath.empty() && !io.Fonts->AddFontFromFileTTF( log.fontPath.c_str() ) )
+        fprintf( stderr, "bench_replay: cannot load %s, text metrics will differ from the recording\n", log.fontPath.c_str() );
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+
+    ExampleApp::Scene scene;
+    if( argc <= 1 )
+    {
+        // Record the script in a context of its own, then round-trip it through the file format.
+        ImGuiContext* replayContext = ImGui::GetCurrentContext();
+        ImGuiContext* recordContext = ImGui::CreateContext();
+        ImGui::SetCurrentContext( recordContext );
+        ImGuiIO& recordIo = ImGui::GetIO();
+        recordIo.IniFilename = nullptr;
+        recordIo.DisplaySize = ImVec2( 1920, 1080 );
+        recordIo.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+        ImGui::LoadIniSettingsFromMemory( ScriptedIni );
+        ExampleApp::Scene recordScene;
+        const InputRecorder::Log recorded = RecordScriptedSession( recordScene );
+        ImGui::DestroyContext( recordContext );
+        ImGui::SetCurrentContext( replayContext );
+
+        std::vector<std::uint8_t> bytes;
+        InputRecorder::WriteLog( recorded, bytes );
+        if( !InputRecorder::ReadLog( log, bytes.data(), bytes.size(), &error ) )
+        {
+            fprintf( stderr, "bench_replay: %s\n", error.c_str() );
+            return 1;
+        }
+        printf( "scripted session: %d frames, %zu events, %zu bytes\n", log.frameCount, log.events.size(), bytes.size() );
+    }
+    InputRecorder::ApplyLogSettings( log );
+
+    const std::vector<InputRecorder::FrameSample> samples = InputRecorder::Replay( log, deltaTime, DrawScene, &scene );
+
+    printf( "%6s %10s %10s %10s %8s\n", "frame", "us", "vertices", "indices", "allocs" );
+    double total = 0.0;
+    std::size_t allocs = 0;
+    for( std::size_t i = 0; i < samples.size(); i++ )
+    {
+        const InputRecorder::FrameSample& s = samples[ i ];
+        printf( "%6zu %10.1f %10d %10d %8zu\n", i, s.cpuMicroseconds, s.vertices, s.indices, s.allocations );
+        total += s.cpuMicroseconds;
+        allocs += s.allocations;
+    }
+    if( !samples.empty() )
+    {
+        std::vector<double> times;
+        for( const InputRecorder::FrameSample& s : samples )
+            times.push_back( s.cpuMicroseconds );
+        std::sort( times.begin(), times.end() );
+        printf( "%zu frames: %.1f us/frame mean, %.1f median, %.1f p99, %.1f max; %zu allocations\n", samples.size(),
+            total / ( double )samples.size(), times[ times.size() / 2 ], times[ times.size() * 99 / 100 ], times.back(), allocs );
+    }
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Headless benchmark for ReflectiveJson serialization: size and encode/decode throughput of a large array of
+// Material, for the text path (dumpJson/fromJson) and the binary paths (CBOR, MessagePack).
+// Every record is encoded/decoded on its own, as an editor snapshot of independent objects would be.
+// The last tables compare reading two fields out of every record with decoding whole records, and encoding the
+// whole vector as one array on one thread with the chunked, thread-pool encoding.
+//
+// Usage: bench_serialization [records]
+
+#include "imgui.h"
+#include "reflective_json.h"
+#include "reflective_json_binary.h"
+#include "reflective_json_parallel.h"
+#include "reflective_json_record.h"
+#include "reflected_types.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+enum class BenchFormat { Json, Cbor, MsgPack, Record };
+
+struct EncodedRecords
+{
+    std::vector<char> text;             // BenchFormat::Json
+    std::vector<std::uint8_t> bytes;    // BenchFormat::Cbor, BenchFormat::MsgPack, BenchFormat::Record
+    std::vector<std::size_t> offsets;   // offsets[i] .. offsets[i + 1] is record i
+
+    std::size_t size() const { return text.size() + bytes.size(); }
+};
+
+static ReflectiveJson::BinaryFormat ToBinaryFormat( BenchFormat format )
+{
+    return format == BenchFormat::Cbor ? ReflectiveJson::BinaryFormat::Cbor : ReflectiveJson::BinaryFormat::MsgPack;
+}
+
+static void Encode( const Material& material, BenchFormat format, EncodedRecords& out )
+{
+    if( format == BenchFormat::Json )
+        ReflectiveJson::dumpJson( material, out.text );
+    else if( format == BenchFormat::Record )
+        ReflectiveJson::writeRecord( material, out.bytes );
+    else
+        ReflectiveJson::dumpBinary( material, out.bytes, ToBinaryFormat( format ) );
+    out.offsets.push_back( out.size() );
+}
+
+static bool Decode( Material& material, BenchFormat format, const EncodedRecords& in, std::size_t index )
+{
+    const std::size_t begin = in.offsets[ index ];
+    const std::size_t end = in.offsets[ index + 1 ];
+    if( format == BenchFormat::Json )
+        return ReflectiveJson::fromJson( material, std::string_view( in.text.data() + begin, end - begin ) );
+    if( format == BenchFormat::Record )
+        return ReflectiveJson::readRecord( material, in.bytes.data() + begin, end - begin );
+    return ReflectiveJson::fromBinary( material, in.bytes.data() + begin, end - begin, ToBinaryFormat( format ) );
+}
+
+static double ElapsedMs( std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+}
+
+static EncodedRecords EncodeAll( BenchFormat format, const std::vector<Material>& materials )
+{
+    EncodedRecords records;
+    records.offsets.reserve( materials.size() + 1 );
+    records.offsets.push_back( 0 );
+    for( const Material& material : materials )
+        Encode( material, format, records );
+    return records;
+}
+
+static void RunFormat( const char* name, BenchFormat format, const std::vector<Material>& materials )
+{
+    auto start = std::chrono::steady_clock::now();
+    const EncodedRecords records = EncodeAll( format, materials );
+    const double encodeMs = ElapsedMs( start );
+
+    std::vector<Material> decoded( materials.size() );
+    start = std::chrono::steady_clock::now();
+    bool ok = true;
+    for( std::size_t i = 0; i < decoded.size(); i++ )
+        ok &= Decode( decoded[ i ], format, records, i );
+    const double decodeMs = ElapsedMs( start );
+
+    // Round-trip check (outside of the timings).
+    for( std::size_t i = 0; i < decoded.size() && ok; i++ )
+        ok = ReflectiveJson::dumpJson( decoded[ i ] ) == ReflectiveJson::dumpJson( materials[ i ] );
+
+    const double megabytes = records.size() / (1024.0 * 1024.0);
+    printf( "%-10s %12.2f %10.1f %10.1f %10.1f %12.1f %12.1f %s\n", name, megabytes, ( double )records.size() / materials.size(),
+        encodeMs, decodeMs, megabytes / (encodeMs / 1000.0), megabytes / (decodeMs / 1000.0), ok ? "ok" : "MISMATCH" );
+}
+
+// Sum of owner.stats.strength and roughness.value over all records: field access vs whole-record decoding.
+static void RunFieldAccess( const std::vector<Material>& materials )
+{
+    const EncodedRecords records = EncodeAll( BenchFormat::Record, materials );
+    static const ReflectiveJson::RecordField<Material> strength( "owner/stats/strength" );
+    static const ReflectiveJson::RecordField<Material> roughness( "roughness/value" );
+
+    auto start = std::chrono::steady_clock::now();
+    double fieldSum = 0.0;
+    for( std::size_t i = 0; i < materials.size(); i++ )
+    {
+        const ReflectiveJson::RecordView record( records.bytes.data() + records.offsets[ i ], records.offsets[ i + 1 ] - records.offsets[ i ] );
+        int s = 0;
+        float r = 0.0f;
+        strength.read( record, s );
+        roughness.read( record, r );
+        fieldSum += s + r;
+    }
+    const double fieldMs = ElapsedMs( start );
+
+    start = std::chrono::steady_clock::now();
+    double decodeSum = 0.0;
+    Material material;
+    for( std::size_t i = 0; i < materials.size(); i++ )
+    {
+        Decode( material, BenchFormat::Record, records, i );
+        decodeSum += material.owner.stats.strength + material.roughness.value;
+    }
+    const double decodeMs = ElapsedMs( start );
+
+    printf( "%-22s %10s %12s\n", "record, 2 fields", "time (ms)", "ns/record" );
+    printf( "%-22s %10.1f %12.1f\n", "RecordField::read", fieldMs, fieldMs * 1e6 / materials.size() );
+    printf( "%-22s %10.1f %12.1f %s\n", "readRecord", decodeMs, decodeMs * 1e6 / materials.size(), fieldSum == decodeSum ? "ok" : "MISMATCH" );
+}
+
+// Whole vector as one JSON / CBOR array: JsonWriter::writeArray() on this thread vs dumpJsonArray() / dumpBinaryArray().
+static void RunArrays( const std::vector<Material>& materials )
+{
+    ReflectiveJson::ThreadPool& pool = ReflectiveJson::defaultThreadPool();
+    printf( "%-22s %10s %12s %9s  (%u threads)\n", "whole array", "1 thread", "thread pool", "speedup", pool.threadCount() );
+
+    auto start = std::chrono::steady_clock::now();
+    std::string serialText;
+    ReflectiveJson::JsonWriter( nlohmann::detail::output_adapter<char>( serialText ) ).writeArray( materials );
+    const double serialJsonMs = ElapsedMs( start );
+    start = std::chrono::steady_clock::now();
+    std::string parallelText;
+    ReflectiveJson::dumpJsonArray( materials, parallelText, pool );
+    const double parallelJsonMs = ElapsedMs( start );
+    printf( "%-22s %10.1f %12.1f %8.2fx %s\n", "json (ms)", serialJsonMs, parallelJsonMs, serialJsonMs / parallelJsonMs,
+        serialText == parallelText ? "ok" : "MISMATCH" );
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::uint8_t> serialBytes;
+    ReflectiveJson::BinaryWriter writer( nlohmann::detail::output_adapter<std::uint8_t>( serialBytes ), ReflectiveJson::BinaryFormat::Cbor );
+    writer.writeArrayHeader( materials.size() );
+    for( const Material& material : materials )
+        writer.writeObject( material );
+    const double serialCborMs = ElapsedMs( start );
+    start = std::chrono::steady_clock::now();
+    std::vector<std::uint8_t> parallelBytes;
+    ReflectiveJson::dumpBinaryArray( materials, parallelBytes, ReflectiveJson::BinaryFormat::Cbor, pool );
+    const double parallelCborMs = ElapsedMs( start );
+    printf( "%-22s %10.1f %12.1f %8.2fx %s\n", "cbor (ms)", serialCborMs, parallelCborMs, serialCborMs / parallelCborMs,
+        serialBytes == parallelBytes ? "ok" : "MISMATCH" );
+}
+
+int main( int argc, char** argv )
+{
+    const int recordCount = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+
+    // Deterministic pseudo-random content so that numbers don't all encode as 0.
+    std::vector<Material> materials( recordCount );
+    unsigned int seed = 12345;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return ( float )(seed >> 8) / ( float )(1u << 24); };
+    for( Material& m : materials )
+    {
+        m.specular = Specular{ next(), next(), next(), 255 };
+        m.emissive = Emissive{ next() * 10.0f, next() * 10.0f, next() * 10.0f, 255 };
+        m.roughness.value = next();
+        m.metallic.value = next();
+        m.owner.name = "Player " + std::to_string( ( int )(next() * 100000) );
+        m.owner.alive = next() > 0.5f;
+        m.owner.stats = Stats{ ( int )(next() * 100), next() * 10.0f };
+    }
+
+    printf( "records: %d\n", recordCount );
+    printf( "%-10s %12s %10s %10s %10s %12s %12s\n", "format", "size (MB)", "B/record", "enc (ms)", "dec (ms)", "enc (MB/s)", "dec (MB/s)" );
+    RunFormat( "json", BenchFormat::Json, materials );
+    RunFormat( "cbor", BenchFormat::Cbor, materials );
+    RunFormat( "msgpack", BenchFormat::MsgPack, materials );
+    RunFormat( "record", BenchFormat::Record, materials );
+    printf( "\n" );
+    RunFieldAccess( materials );
+    printf( "\n" );
+    RunArrays( materials );
+    return 0;
+}
@@ -0,0 +1,426 @@
+// ExampleApp: the reflected windows of the example application and the state behind them.
+// main.cpp draws them every frame; bench_replay draws the very same windows headless, so a session recorded with the
+// "Record input" button replays on the widgets it was recorded on.
+//
+// - Scene owns the inspected objects and the UI state of every window (selection, search, undo journal, remote
+//   client, scene file, component list, ...).
+// - DrawReflectedWindows() submits the default Debug window (material, stats, light, frame buffer, squad, sensor),
+//   "Lights", "Selected lights", "Materials", "Remote lights", "Scene file", "Hello, world!" and, when enabled, the
+//   demo window and "Another Window". It calls NewFrame()/Render() neither before nor after.
+// - What needs the platform stays with the caller: main.cpp runs stepLight() on a simulation thread, sets the frame
+//   buffer textures, watches material.json, calls inputRecorder.captureFrame() and prints the material patches.
+
+#pragma once
+
+#include "imgui.h"
+#include "alloc_counter.h"
+#include "input_recorder.h"
+#include "reflected_types.h"
+#include "reflective_json.h"
+#include "reflective_json_multi.h"
+#include "reflective_json_parallel.h"
+#include "reflective_json_patch.h"
+#include "reflective_json_remote.h"
+#include "reflective_json_scene.h"
+#include "reflective_json_search.h"
+#include "reflective_json_sync.h"
+#include "reflective_json_table.h"
+#include "reflective_json_undo.h"
+#include "virtual_list.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <math.h>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ExampleApp
+{
+    // One line of the "Hello, world!" component list
+    struct MyComponent
+    {
+        char text[ 128 ] = "";
+        int combo_current = 0;
+        bool submitted = false;
+    };
+
+    struct Scene
+    {
+        // Default Debug window. 'light' belongs to whoever calls stepLight(); the window shows the bridge's snapshots.
+        Material material{};
+        ReflectiveJson::ChangeList materialChanges;
+        ReflectiveJson::UndoJournal materialJournal{ 16 * 1024 };
+        FILE* patchOutput = nullptr;                // material edits are printed here as JSON Patches
+        Light light{ ImVec4( 1.0f, 0.2f, 0.2f, 1.0f ), 10.0f };
+        ReflectiveJson::SnapshotBridge<Light> lightBridge{ light };
+        ReflectiveJson::ChangeList lightChanges;
+        GFrameBuffer frameBuffer{};
+        Squad squad{ "Alpha", std::vector<Stats>( 100000 ), std::vector<float>( 1000000 ) };
+        SensorTrace sensor{ "Accelerometer", std::vector<float>( 4000000 ), {} };
+
+        // "Lights" and "Selected lights": one table row per instance, edits in the panel apply to every selected light
+        std::vector<Light> lights = std::vector<Light>( 200000, Light{ ImVec4( 1.0f, 1.0f, 1.0f, 1.0f ), 1.0f } );
+        ReflectiveJson::InstanceTableState lightsTable;
+        std::vector<int> selectedLights;
+
+        // "Materials": field search over 2000 materials
+        std::vector<Material> materials = std::vector<Material>( 2000 );
+        ReflectiveJson::FieldSearch materialSearch;
+
+        // "Remote lights": a stand-in for a headless service that owns its lights and serves them on a local socket
+        // once "Serve lights" is checked, and a client that connects to it like an inspector in another process would.
+        std::string serviceEndpoint;
+        std::string serviceError;
+        std::atomic<bool> serviceRunning{ false };
+        std::thread serviceThread;
+        ReflectiveJson::RemoteClient<Light> remote;
+        ReflectiveJson::ChangeList remoteChanges;
+
+        // "Scene file": a million players in the temp directory, written and memory-mapped on request
+        ReflectiveJson::SceneView<Player> playerScene;
+        std::string scenePath;
+        std::string sceneError;
+
+        // "Hello, world!"
+        bool showDemoWindow = false;
+        bool showAnotherWindow = false;
+        ImVec4 clearColor = ImVec4( 0.45f, 0.55f, 0.60f, 1.00f );
+        float f = 0.0f;
+        int counter = 0;
+        AllocCounter::FrameStats lastFrameAllocs{};
+        InputRecorder::Recorder inputRecorder;
+        std::string fontPath;                       // stored in recorded logs, so the replay loads the same font
+        VirtualList::ChunkedStore<MyComponent> components;
+
+        Scene()
+        {
+            for( std::size_t i = 0; i < squad.weights.size(); i++ )
+                squad.weights[ i ] = ( float )(i % 100) * 0.01f;
+            for( std::size_t i = 0; i < sensor.samples.size(); i++ )
+                sensor.samples[ i ] = sinf( ( float )i * 0.0005f ) + 0.2f * sinf( ( float )i * 0.37f ) + ((i % 100000) == 0 ? 3.0f : 0.0f);
+            for( int i = 0; i < IM_ARRAYSIZE( sensor.recent ); i++ )
+                sensor.recent[ i ] = cosf( ( float )i * 0.05f );
+            for( std::size_t i = 0; i < materials.size(); i++ )
+            {
+                materials[ i ].roughness.value = ( float )(i % 10) * 0.1f;
+                materials[ i ].owner = Player{ "Owner " + std::to_string( i ), (i % 2) == 0, Stats{ ( int )(i % 101), ( float )(i % 11) } };
+            }
+#ifdef _WIN32
+            serviceEndpoint = "127.0.0.1:7777";
+#else
+            serviceEndpoint = "unix:" + ( std::filesystem::temp_directory_path() / "reflective_json_lights.sock" ).string();
+#endif
+            scenePath = ( std::filesystem::temp_directory_path() / "players.scene" ).string();
+        }
+
+        Scene( const Scene& ) = delete;
+        Scene& operator=( const Scene& ) = delete;
+
+        ~Scene()
+        {
+            stopService();
+        }
+
+        // One simulation tick of 'light': applies the UI edits, rotates its hue, publishes a snapshot.
+        // Called from a single thread (the simulation thread in main.cpp, the frame loop in bench_replay).
+        void stepLight()
+        {
+            lightBridge.applyPendingWrites( light );
+            float h, s, v;
+            ImGui::ColorConvertRGBtoHSV( light.color.x, light.color.y, light.color.z, h, s, v );
+            h = ImFmod( h + 0.0005f, 1.0f );
+            ImGui::ColorConvertHSVtoRGB( h, s, v, light.color.x, light.color.y, light.color.z );
+            lightBridge.publish( light );
+        }
+
+        bool startService()
+        {
+            if( serviceThread.joinable() )
+                return true;
+            auto server = std::make_unique<ReflectiveJson::RemoteServer<Light>>();
+            if( !server->listen( serviceEndpoint, &serviceError ) )
+                return false;
+            serviceError.clear();
+            serviceRunning = true;
+            serviceThread = std::thread( [this, server = std::move( server )]()
+            {
+                std::vector<Light> serviceLights( 5000, Light{ ImVec4( 1.0f, 0.8f, 0.6f, 1.0f ), 10.0f } );
+                for( int tick = 0; serviceRunning.load( std::memory_order_relaxed ); tick++ )
+                {
+                    server->poll( serviceLights );
+                    serviceLights[ ( std::size_t )tick % serviceLights.size() ].intensity = ( float )(tick % 100);   // one light per tick
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                }
+            } );
+            return true;
+        }
+
+        void stopService()
+        {
+            serviceRunning = false;
+            if( serviceThread.joinable() )
+                serviceThread.join();
+        }
+    };
+
+    namespace detail
+    {
+        inline void DrawLightsWindows( Scene& scene )
+        {
+            ImGui::Begin( "Lights" );
+            ImGui::Text( "%d lights", ( int )scene.lights.size() );
+            ImGui::SameLine();
+            if( ImGui::Button( "Save lights.json" ) )
+            {
+                // Encoded in chunks on all cores, stitched into one JSON array
+                std::string text;
+                ReflectiveJson::dumpJsonArray( scene.lights, text );
+                std::ofstream( "lights.json", std::ios::binary ).write( text.data(), ( std::streamsize )text.size() );
+            }
+            ReflectiveJson::DrawInstanceTable( "##lights", scene.lights, scene.lightsTable );
+            ImGui::End();
+
+            ReflectiveJson::collectSelection( scene.lightsTable, scene.selectedLights );
+            ImGui::Begin( "Selected lights" );
+            if( scene.selectedLights.empty() )
+                ImGui::TextDisabled( "Select rows in the Lights table" );
+            ReflectiveJson::DrawImGuiMulti( scene.lights, scene.selectedLights );
+            ImGui::End();
+        }
+
+        // Typing filters the per-type path index, a click opens the headers down to the field
+        inline void DrawMaterialsWindow( Scene& scene )
+        {
+            ImGui::Begin( "Materials" );
+            ImGui::TextDisabled( "Search by field path, e.g. owner.stats.agility" );
+            ReflectiveJson::DrawFieldSearch( "##field search", scene.materials.data(), scene.materials.size(), scene.materialSearch );
+            ImGui::BeginChild( "##materials" );
+            for( Material& m : scene.materials )
+                ReflectiveJson::DrawImGui( m );
+            ImGui::EndChild();
+            ImGui::End();
+        }
+
+        // A mirror of the service's lights, edits are sent back
+        inline void DrawRemoteWindow( Scene& scene )
+        {
+            ReflectiveJson::RemoteClient<Light>& remote = scene.remote;
+            ImGui::Begin( "Remote lights" );
+            bool serving = scene.serviceRunning.load();
+            if( ImGui::Checkbox( "Serve lights", &serving ) )
+            {
+                if( serving )
+                    scene.startService();
+                else
+                    scene.stopService();
+            }
+            ImGui::SameLine();
+            ImGui::TextDisabled( "%s", scene.serviceEndpoint.c_str() );
+            if( !scene.serviceError.empty() )
+                ImGui::TextDisabled( "%s", scene.serviceError.c_str() );
+            if( !remote.connected() )
+            {
+                if( ImGui::Button( "Connect" ) )
+                    remote.connect( scene.serviceEndpoint );
+                if( !remote.error().empty() )
+                    ImGui::TextDisabled( "%s", remote.error().c_str() );
+            }
+            else if( ImGui::Button( "Disconnect" ) )
+            {
+                remote.disconnect();
+            }
+            remote.poll();
+            const ReflectiveJson::RemoteStats& remoteStats = remote.stats();
+            ImGui::Text( "%d lights, %llu bytes received, %llu values", ( int )remote.objects().size(),
+                ( unsigned long long )remoteStats.bytesReceived, ( unsigned long long )remoteStats.changesReceived );
+            ImGuiListClipper clipper;
+            clipper.Begin( ( int )remote.objects().size() );
+            while( clipper.Step() )
+                for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ )
+                {
+                    ImGui::PushID( i );
+                    if( ImGui::TreeNode( "##light", "Light %d", i ) )
+                    {
+                        if( ReflectiveJson::DrawImGui( remote.objects()[ i ], scene.remoteChanges, true ) )
+                        {
+                            remote.sendEdits( ( std::size_t )i, scene.remoteChanges );
+                            scene.remoteChanges.clear();
+                        }
+                        ImGui::TreePop();
+                    }
+                    ImGui::PopID();
+                }
+            ImGui::End();
+        }
+
+        // Only the visible rows exist, only the opened records are decoded
+        inline void DrawSceneFileWindow( Scene& scene )
+        {
+            ImGui::Begin( "Scene file" );
+            if( !scene.playerScene.isOpen() )
+            {
+                ImGui::TextWrapped( "%s", scene.scenePath.c_str() );
+                if( ImGui::Button( "Write 1M players" ) )
+                {
+                    std::vector<Player> players( 1000000 );
+                    for( std::size_t i = 0; i < players.size(); i++ )
+                        players[ i ] = Player{ "Player " + std::to_string( i ), (i % 3) != 0, Stats{ ( int )(i % 101), ( float )(i % 11) } };
+                    if( ReflectiveJson::writeScene( scene.scenePath, players.data(), players.size(), &scene.sceneError ) && scene.playerScene.open( scene.scenePath, &scene.sceneError ) )
+                        scene.sceneError.clear();
+                }
+                ImGui::SameLine();
+                if( ImGui::Button( "Open" ) && scene.playerScene.open( scene.scenePath, &scene.sceneError ) )
+                    scene.sceneError.clear();
+            }
+            if( !scene.sceneError.empty() )
+                ImGui::TextDisabled( "%s", scene.sceneError.c_str() );
+            ImGui::Text( "%d records, %d decoded", ( int )scene.playerScene.size(), ( int )scene.playerScene.decodedCount() );
+            ImGuiListClipper clipper;
+            clipper.Begin( ( int )scene.playerScene.size() );
+            while( clipper.Step() )
+                for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ )
+                {
+                    ImGui::PushID( i );
+                    if( ImGui::TreeNode( "##record", "Record %d", i ) )
+                    {
+                        ReflectiveJson::DrawImGui( scene.playerScene.at( ( std::size_t )i ), true );
+                        ImGui::TreePop();
+                    }
+                    ImGui::PopID();
+                }
+            ImGui::End();
+        }
+
+        inline void DrawHelloWindow( Scene& scene )
+        {
+            ImGuiIO& io = ImGui::GetIO();
+            ImGui::Begin( "Hello, world!" );                          // Create a window called "Hello, world!" and append into it.
+
+            ImGui::Text( "This is some useful text." );               // Display some text (you can use a format strings too)
+            ImGui::Checkbox( "Demo Window", &scene.showDemoWindow );  // Edit bools storing our window open/close state
+            ImGui::Checkbox( "Another Window", &scene.showAnotherWindow );
+
+            ImGui::SliderFloat( "float", &scene.f, 0.0f, 1.0f );      // Edit 1 float using a slider from 0.0f to 1.0f
+            ImGui::ColorEdit3( "clear color", ( float* )&scene.clearColor ); // Edit 3 floats representing a color
+
+            if( ImGui::Button( "Button" ) )                            // Buttons return true when clicked (most widgets return true when edited/activated)
+                scene.counter++;
+            ImGui::SameLine();
+            ImGui::Text( "counter = %d", scene.counter );
+
+            ImGui::Text( "Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate );
+            ImGui::Text( "Material undo: %d steps, %d redo (%zu / %zu bytes)", scene.materialJournal.undoCount(), scene.materialJournal.redoCount(), scene.materialJournal.bytesUsed(), scene.materialJournal.budget() );
+            const AllocCounter::FrameStats& allocs = scene.lastFrameAllocs;
+            ImGui::Text( "Heap allocations last frame (UI thread): %zu new, %zu ImGui (%zu bytes)", allocs.newCount, allocs.imguiCount, allocs.newBytes + allocs.imguiBytes );
+            InputRecorder::Recorder& recorder = scene.inputRecorder;
+            if( !recorder.recording() && ImGui::Button( "Record input" ) )
+                recorder.start( scene.fontPath.c_str() );
+            else if( recorder.recording() && ImGui::Button( "Stop and save session.inputlog" ) )
+            {
+                recorder.stop();
+                std::string error;
+                if( !InputRecorder::SaveLog( recorder.log(), "session.inputlog", &error ) )
+                    fprintf( stderr, "Input recorder: %s\n", error.c_str() );
+            }
+            ImGui::SameLine();
+            ImGui::Text( "%d frames, %zu events", recorder.log().frameCount, recorder.log().events.size() );
+
+            // Components: one line each, only the visible ones are submitted
+            static const char* combo_items[] = { "Option 1", "Option 2", "Option 3" };
+            if( ImGui::Button( "Add Component" ) )
+                scene.components.push_back( MyComponent() );
+            ImGui::SameLine();
+            if( ImGui::Button( "Add 100000" ) )
+                for( int i = 0; i < 100000; i++ )
+                    scene.components.push_back( MyComponent() );
+            ImGui::SameLine();
+            ImGui::Text( "%zu components", scene.components.size() );
+
+            if( !scene.components.empty() )
+            {
+                VirtualList::DrawList( "##components", scene.components, 12, []( int index, MyComponent& component )
+                {
+                    ImGui::AlignTextToFramePadding();
+                    ImGui::Text( "Component #%d", index + 1 );
+                    ImGui::SameLine();
+                    ImGui::SetNextItemWidth( ImGui::GetFontSize() * 10.0f );
+                    ImGui::InputText( "Text", component.text, IM_ARRAYSIZE( component.text ) );
+                    ImGui::SameLine();
+                    ImGui::SetNextItemWidth( ImGui::GetFontSize() * 7.0f );
+                    ImGui::Combo( "Combo", &component.combo_current, combo_items, IM_ARRAYSIZE( combo_items ) );
+                    ImGui::SameLine();
+                    if( ImGui::Button( "Submit" ) )
+                    {
+                        component.submitted = true;
+                        printf( "Component %d: Text='%s', Combo='%s'\n", index + 1, component.text, combo_items[ component.combo_current ] );
+                    }
+                    if( component.submitted )
+                    {
+                        ImGui::SameLine();
+                        ImGui::TextColored( ImVec4( 0, 1, 0, 1 ), "Submitted!" );
+                    }
+                } );
+            }
+
+            ImGui::End();
+        }
+    } // namespace detail
+
+    // Submits every window of the example, in the same order and with the same labels on every caller.
+    inline void DrawReflectedWindows( Scene& scene )
+    {
+        // 1. Show the big demo window (Most of the sample code is in ImGui::ShowDemoWindow()! You can browse its code to learn more about Dear ImGui!).
+        if( scene.showDemoWindow )
+            ImGui::ShowDemoWindow( &scene.showDemoWindow );
+
+        // Only the edited fields are sent, as a JSON Patch
+        if( scene.materialChanges.observer == nullptr )
+            scene.materialJournal.attach( scene.materialChanges );
+        scene.materialJournal.newFrame();
+        if( ImGui::Shortcut( ImGuiMod_Ctrl | ImGuiKey_Z, ImGuiInputFlags_RouteGlobal ) )
+            scene.materialJournal.undo();
+        if( ImGui::Shortcut( ImGuiMod_Ctrl | ImGuiKey_Y, ImGuiInputFlags_RouteGlobal ) )
+            scene.materialJournal.redo();
+        if( ReflectiveJson::DrawImGui( scene.material, scene.materialChanges ) )
+        {
+            if( scene.patchOutput != nullptr )
+                fprintf( scene.patchOutput, "%s\n", ReflectiveJson::makeJsonPatch( scene.material, scene.materialChanges ).dump().c_str() );
+            scene.materialChanges.clear();
+        }
+        Stats stats{};
+        ReflectiveJson::DrawImGui( stats );
+
+        Light& shownLight = scene.lightBridge.acquire();
+        if( ReflectiveJson::DrawImGui( shownLight, scene.lightChanges ) )
+        {
+            scene.lightBridge.queueWrites( shownLight, scene.lightChanges );
+            scene.lightChanges.clear();
+        }
+
+        ReflectiveJson::DrawImGui( scene.frameBuffer );
+        ReflectiveJson::DrawImGui( scene.squad );
+        ReflectiveJson::DrawImGui( scene.sensor );
+
+        detail::DrawLightsWindows( scene );
+        detail::DrawMaterialsWindow( scene );
+        detail::DrawRemoteWindow( scene );
+        detail::DrawSceneFileWindow( scene );
+
+        // 2. Show a simple window that we create ourselves. We use a Begin/End pair to create a named window.
+        detail::DrawHelloWindow( scene );
+
+        // 3. Show another simple window.
+        if( scene.showAnotherWindow )
+        {
+            ImGui::Begin( "Another Window", &scene.showAnotherWindow );   // Pass a pointer to our bool variable (the window will have a closing button that will clear the bool when clicked)
+            ImGui::Text( "Hello from another window!" );
+            if( ImGui::Button( "Close Me" ) )
+                scene.showAnotherWindow = false;
+            ImGui::End();
+        }
+    }
+} // namespace ExampleApp
@@ -0,0 +1,429 @@
+// InputRecorder: records the input events an application feeds to ImGuiIO, and replays them headlessly for
+// reproducible frame-time measurements of real sessions.
+//
+// - Recorder::captureFrame(), called right before ImGui::NewFrame(), copies the events queued since the previous
+//   frame (AddMousePosEvent(), AddMouseButtonEvent(), AddMouseWheelEvent(), AddKeyEvent(), AddInputCharacter(),
+//   AddFocusEvent(): everything in the input queue) with the number of the frame they were submitted for.
+// - The log also keeps what decides where things are on screen: display size, the style, the .ini settings (window
+//   positions and sizes), the config flags and the font file, taken when recording starts.
+// - Replay() feeds each frame's events back with a fixed DeltaTime and measures every frame: CPU time of NewFrame +
+//   the caller's UI + Render, vertices, indices and heap allocations (see alloc_counter.h).
+// The replay is only faithful when it draws the same UI as the recorded session, in the same build.
+//
+// File layout (little-endian): "IMINPUT\0", u32 version, u32 frame count, f32 display width, f32 display height,
+// u32 config flags, u32 style size + ImGuiStyle bytes, u32 + font path, u32 + .ini text, then for every frame that
+// has events: varint frame gap, varint event count, events (u8 type, then a few bytes depending on the type).
+//
+// Usage:
+//   static InputRecorder::Recorder recorder;
+//   recorder.start( "../../misc/fonts/Roboto-Medium.ttf" );
+//   // every frame, after the platform backend's NewFrame():
+//   recorder.captureFrame();
+//   ImGui::NewFrame();
+//   ...
+//   recorder.stop();
+//   InputRecorder::SaveLog( recorder.log(), "session.inputlog" );
+//   // headless, in the benchmark:
+//   InputRecorder::Log log;
+//   InputRecorder::LoadLog( log, "session.inputlog" );
+//   InputRecorder::ApplyLogSettings( log );      // before the first frame
+//   std::vector<InputRecorder::FrameSample> samples = InputRecorder::Replay( log, 1.0f / 60.0f, DrawScene, nullptr );
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "alloc_counter.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace InputRecorder
+{
+    struct LogFrame
+    {
+        int frame;                      // 0 = first frame recorded
+        std::uint32_t firstEvent;       // into Log::events
+        std::uint32_t eventCount;
+    };
+
+    struct Log
+    {
+        int frameCount = 0;
+        ImVec2 displaySize;
+        ImGuiConfigFlags configFlags = 0;
+        std::vector<std::uint8_t> style;    // ImGuiStyle bytes, ignored when sizeof( ImGuiStyle ) differs
+        std::string fontPath;
+        std::string ini;
+        std::vector<LogFrame> frames;       // frames with events only, ascending
+        std::vector<ImGuiInputEvent> events;
+    };
+
+    struct FrameSample
+    {
+        double cpuMicroseconds;
+        int vertices;
+        int indices;
+        std::size_t allocations;
+    };
+
+    class Recorder
+    {
+    public:
+        // Starts a new log. fontPath is stored for the replay; it should be the font the application loaded.
+        void start( const char* fontPath = nullptr )
+        {
+            ImGuiContext& g = *GImGui;
+            ImGuiIO& io = ImGui::GetIO();
+            m_log = Log();
+            m_log.displaySize = io.DisplaySize;
+            m_log.configFlags = io.ConfigFlags;
+            m_log.style.resize( sizeof( ImGuiStyle ) );
+            std::memcpy( m_log.style.data(), &ImGui::GetStyle(), sizeof( ImGuiStyle ) );
+            m_log.fontPath = fontPath ? fontPath : "";
+            m_log.ini = ImGui::SaveIniSettingsToMemory();
+            m_nextEventId = g.InputEventsNextEventId;
+            m_recording = true;
+        }
+
+        void stop() { m_recording = false; }
+        bool recording() const { return m_recording; }
+        const Log& log() const { return m_log; }
+
+        // Call right before ImGui::NewFrame(), once per frame.
+        void captureFrame()
+        {
+            if( !m_recording )
+                return;
+            ImGuiContext& g = *GImGui;
+            const std::uint32_t first = ( std::uint32_t )m_log.events.size();
+            for( const ImGuiInputEvent& e : g.InputEventsQueue )
+                if( e.EventId >= m_nextEventId && !e.AddedByTestEngine )     // events left from the previous frame were recorded then
+                    m_log.events.push_back( e );
+            m_nextEventId = g.InputEventsNextEventId;
+            if( m_log.events.size() > first )
+                m_log.frames.push_back( LogFrame{ m_log.frameCount, first, ( std::uint32_t )m_log.events.size() - first } );
+            m_log.frameCount++;
+        }
+
+    private:
+        Log m_log;
+        ImU32 m_nextEventId = 0;
+        bool m_recording = false;
+    };
+
+    namespace detail
+    {
+        constexpr char LogMagic[ 8 ] = { 'I', 'M', 'I', 'N', 'P', 'U', 'T', '\0' };
+        constexpr std::uint32_t LogVersion = 1;
+
+        inline void putU32( std::vector<std::uint8_t>& out, std::uint32_t v )
+        {
+            for( int i = 0; i < 4; i++ )
+                out.push_back( ( std::uint8_t )(v >> (8 * i)) );
+        }
+
+        inline void putF32( std::vector<std::uint8_t>& out, float f )
+        {
+            std::uint32_t v;
+            std::memcpy( &v, &f, 4 );
+            putU32( out, v );
+        }
+
+        inline void putVarint( std::vector<std::uint8_t>& out, std::uint32_t v )
+        {
+            for( ; v >= 0x80; v >>= 7 )
+                out.push_back( ( std::uint8_t )(v | 0x80) );
+            out.push_back( ( std::uint8_t )v );
+        }
+
+        inline void putBytes( std::vector<std::uint8_t>& out, const void* data, std::size_t size )
+        {
+            putU32( out, ( std::uint32_t )size );
+            out.insert( out.end(), static_cast< const std::uint8_t* >(data), static_cast< const std::uint8_t* >(data) + size );
+        }
+
+        struct Reader
+        {
+            const std::uint8_t* data;
+            std::size_t size;
+            std::size_t pos = 0;
+            bool failed = false;
+
+            const std::uint8_t* take( std::size_t count )
+            {
+                if( failed || size - pos < count )
+                {
+                    failed = true;
+                    return nullptr;
+                }
+                pos += count;
+                return data + pos - count;
+            }
+            std::uint8_t u8() { const std::uint8_t* p = take( 1 ); return p ? *p : 0; }
+            std::uint32_t u32()
+            {
+                const std::uint8_t* p = take( 4 );
+                return p ? ( std::uint32_t )p[ 0 ] | (( std::uint32_t )p[ 1 ] << 8) | (( std::uint32_t )p[ 2 ] << 16) | (( std::uint32_t )p[ 3 ] << 24) : 0;
+            }
+            float f32() { const std::uint32_t v = u32(); float f; std::memcpy( &f, &v, 4 ); return f; }
+            std::uint32_t varint()
+            {
+                std::uint32_t v = 0;
+                for( int shift = 0; shift < 35; shift += 7 )
+                {
+                    const std::uint8_t b = u8();
+                    v |= ( std::uint32_t )(b & 0x7F) << shift;
+                    if( !(b & 0x80) )
+                        return v;
+                }
+                failed = true;
+                return 0;
+            }
+            std::string bytes()
+            {
+                const std::uint32_t n = u32();
+                const std::uint8_t* p = take( n );
+                return p ? std::string( reinterpret_cast< const char* >(p), n ) : std::string();
+            }
+        };
+
+        inline bool isAnalogKey( ImGuiKey key )
+        {
+            return key >= ImGuiKey_GamepadStart && key <= ImGuiKey_GamepadRStickDown;
+        }
+    } // namespace detail
+
+    inline void WriteLog( const Log& log, std::vector<std::uint8_t>& out )
+    {
+        out.insert( out.end(), detail::LogMagic, detail::LogMagic + 8 );
+        detail::putU32( out, detail::LogVersion );
+        detail::putU32( out, ( std::uint32_t )log.frameCount );
+        detail::putF32( out, log.displaySize.x );
+        detail::putF32( out, log.displaySize.y );
+        detail::putU32( out, ( std::uint32_t )log.configFlags );
+        detail::putBytes( out, log.style.data(), log.style.size() );
+        detail::putBytes( out, log.fontPath.data(), log.fontPath.size() );
+        detail::putBytes( out, log.ini.data(), log.ini.size() );
+        int previous = -1;
+        for( const LogFrame& frame : log.frames )
+        {
+            detail::putVarint( out, ( std::uint32_t )(frame.frame - previous - 1) );
+            detail::putVarint( out, frame.eventCount );
+            previous = frame.frame;
+            for( std::uint32_t i = 0; i < frame.eventCount; i++ )
+            {
+                const ImGuiInputEvent& e = log.events[ frame.firstEvent + i ];
+                out.push_back( ( std::uint8_t )e.Type );
+                switch( e.Type )
+                {
+                case ImGuiInputEventType_MousePos:
+                    detail::putF32( out, e.MousePos.PosX );
+                    detail::putF32( out, e.MousePos.PosY );
+                    out.push_back( ( std::uint8_t )e.MousePos.MouseSource );
+                    break;
+                case ImGuiInputEventType_MouseWheel:
+                    detail::putF32( out, e.MouseWheel.WheelX );
+                    detail::putF32( out, e.MouseWheel.WheelY );
+                    out.push_back( ( std::uint8_t )e.MouseWheel.MouseSource );
+                    break;
+                case ImGuiInputEventType_MouseButton:
+                    out.push_back( ( std::uint8_t )e.MouseButton.Button );
+                    out.push_back( e.MouseButton.Down ? 1 : 0 );
+                    out.push_back( ( std::uint8_t )e.MouseButton.MouseSource );
+                    break;
+                case ImGuiInputEventType_Key:
+                    detail::putVarint( out, ( std::uint32_t )e.Key.Key );
+                    out.push_back( e.Key.Down ? 1 : 0 );
+                    if( detail::isAnalogKey( e.Key.Key ) )
+                        detail::putF32( out, e.Key.AnalogValue );
+                    break;
+                case ImGuiInputEventType_Text:
+                    detail::putVarint( out, e.Text.Char );
+                    break;
+                case ImGuiInputEventType_Focus:
+                    out.push_back( e.AppFocused.Focused ? 1 : 0 );
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    inline bool ReadLog( Log& log, const std::uint8_t* data, std::size_t size, std::string* error = nullptr )
+    {
+        log = Log();
+        detail::Reader in{ data, size };
+        const std::uint8_t* magic = in.take( 8 );
+        if( !magic || std::memcmp( magic, detail::LogMagic, 8 ) != 0 || in.u32() != detail::LogVersion )
+        {
+            if( error )
+                *error = "Not an input log, or an unsupported version";
+            return false;
+        }
+        log.frameCount = ( int )in.u32();
+        log.displaySize.x = in.f32();
+        log.displaySize.y = in.f32();
+        log.configFlags = ( ImGuiConfigFlags )in.u32();
+        const std::string style = in.bytes();
+        log.style.assign( style.begin(), style.end() );
+        log.fontPath = in.bytes();
+        log.ini = in.bytes();
+        int frame = -1;
+        while( !in.failed && in.pos < in.size )
+        {
+            frame += ( int )in.varint() + 1;
+            const std::uint32_t count = in.varint();
+            log.frames.push_back( LogFrame{ frame, ( std::uint32_t )log.events.size(), count } );
+            for( std::uint32_t i = 0; i < count && !in.failed; i++ )
+            {
+                ImGuiInputEvent e;
+                e.Type = ( ImGuiInputEventType )in.u8();
+                switch( e.Type )
+                {
+                case ImGuiInputEventType_MousePos:
+                    e.Source = ImGuiInputSource_Mouse;
+                    e.MousePos.PosX = in.f32();
+                    e.MousePos.PosY = in.f32();
+                    e.MousePos.MouseSource = ( ImGuiMouseSource )in.u8();
+                    break;
+                case ImGuiInputEventType_MouseWheel:
+                    e.Source = ImGuiInputSource_Mouse;
+                    e.MouseWheel.WheelX = in.f32();
+                    e.MouseWheel.WheelY = in.f32();
+                    e.MouseWheel.MouseSource = ( ImGuiMouseSource )in.u8();
+                    break;
+                case ImGuiInputEventType_MouseButton:
+                    e.Source = ImGuiInputSource_Mouse;
+                    e.MouseButton.Button = in.u8();
+                    e.MouseButton.Down = in.u8() != 0;
+                    e.MouseButton.MouseSource = ( ImGuiMouseSource )in.u8();
+                    break;
+                case ImGuiInputEventType_Key:
+                    e.Source = ImGuiInputSource_Keyboard;
+                    e.Key.Key = ( ImGuiKey )in.varint();
+                    e.Key.Down = in.u8() != 0;
+                    e.Key.AnalogValue = detail::isAnalogKey( e.Key.Key ) ? in.f32() : (e.Key.Down ? 1.0f : 0.0f);
+                    break;
+                case ImGuiInputEventType_Text:
+                    e.Source = ImGuiInputSource_Keyboard;
+                    e.Text.Char = in.varint();
+                    break;
+                case ImGuiInputEventType_Focus:
+                    e.AppFocused.Focused = in.u8() != 0;
+                    break;
+                default:
+                    in.failed = true;
+                    break;
+                }
+                log.events.push_back( e );
+            }
+        }
+        if( in.failed || frame >= log.frameCount )
+        {
+            if( error )
+                *error = "Truncated or corrupted input log";
+            return false;
+        }
+        return true;
+    }
+
+    inline bool SaveLog( const Log& log, const char* path, std::string* error = nullptr )
+    {
+        std::vector<std::uint8_t> bytes;
+        WriteLog( log, bytes );
+        std::ofstream file( path, std::ios::binary );
+        if( !file.write( reinterpret_cast< const char* >(bytes.data()), ( std::streamsize )bytes.size() ) )
+        {
+            if( error )
+                *error = std::string( "Cannot write " ) + path;
+            return false;
+        }
+        return true;
+    }
+
+    inline bool LoadLog( Log& log, const char* path, std::string* error = nullptr )
+    {
+        std::ifstream file( path, std::ios::binary );
+        if( !file )
+        {
+            if( error )
+                *error = std::string( "Cannot open " ) + path;
+            return false;
+        }
+        const std::vector<std::uint8_t> bytes( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+        return ReadLog( log, bytes.data(), bytes.size(), error );
+    }
+
+    // Restores the recorded display size, config flags, style and window settings. Call before the first replayed
+    // frame; the font has to be loaded by the caller (Log::fontPath) before the atlas is built.
+    inline void ApplyLogSettings( const Log& log )
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = log.displaySize;
+        io.ConfigFlags = log.configFlags;
+        if( log.style.size() == sizeof( ImGuiStyle ) )
+            std::memcpy( &ImGui::GetStyle(), log.style.data(), sizeof( ImGuiStyle ) );
+        if( !log.ini.empty() )
+            ImGui::LoadIniSettingsFromMemory( log.ini.data(), log.ini.size() );
+    }
+
+    // Queues the events of one recorded frame, through the same ImGuiIO functions the backends use.
+    inline void FeedEvents( const Log& log, const LogFrame& frame )
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        for( std::uint32_t i = 0; i < frame.eventCount; i++ )
+        {
+            const ImGuiInputEvent& e = log.events[ frame.firstEvent + i ];
+            switch( e.Type )
+            {
+            case ImGuiInputEventType_MousePos:
+                io.AddMouseSourceEvent( e.MousePos.MouseSource );
+                io.AddMousePosEvent( e.MousePos.PosX, e.MousePos.PosY );
+                break;
+            case ImGuiInputEventType_MouseWheel:
+                io.AddMouseSourceEvent( e.MouseWheel.MouseSource );
+                io.AddMouseWheelEvent( e.MouseWheel.WheelX, e.MouseWheel.WheelY );
+                break;
+            case ImGuiInputEventType_MouseButton:
+                io.AddMouseSourceEvent( e.MouseButton.MouseSource );
+                io.AddMouseButtonEvent( e.MouseButton.Button, e.MouseButton.Down );
+                break;
+            case ImGuiInputEventType_Key:       io.AddKeyAnalogEvent( e.Key.Key, e.Key.Down, e.Key.AnalogValue ); break;
+            case ImGuiInputEventType_Text:      io.AddInputCharacter( e.Text.Char ); break;
+            case ImGuiInputEventType_Focus:     io.AddFocusEvent( e.AppFocused.Focused ); break;
+            default:                            break;
+            }
+        }
+    }
+
+    // Runs log.frameCount frames: events, io.DeltaTime = deltaTime, NewFrame(), drawFrame( user ), Render().
+    // Returns one sample per frame.
+    inline std::vector<FrameSample> Replay( const Log& log, float deltaTime, void ( *drawFrame )(void* user), void* user )
+    {
+        std::vector<FrameSample> samples;
+        samples.reserve( ( std::size_t )log.frameCount );
+        std::size_t next = 0;
+        for( int f = 0; f < log.frameCount; f++ )
+        {
+            AllocCounter::BeginFrame();
+            const auto start = std::chrono::steady_clock::now();
+            if( next < log.frames.size() && log.frames[ next ].frame == f )
+                FeedEvents( log, log.frames[ next++ ] );
+            ImGui::GetIO().DeltaTime = deltaTime;
+            ImGui::NewFrame();
+            drawFrame( user );
+            ImGui::Render();
+            const auto end = std::chrono::steady_clock::now();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            samples.push_back( FrameSample{ std::chrono::duration<double, std::micro>( end - start ).count(),
+                drawData->TotalVtxCount, drawData->TotalIdxCount, AllocCounter::GetFrameStats().TotalCount() } );
+        }
+        return samples;
+    }
+} // namespace InputRecorder
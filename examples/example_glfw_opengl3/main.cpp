@@ -33,344 +33,95 @@
 
 #include <json.hpp>
 #include <iostream>
-
-using json = nlohmann::json;
-
-#define TEXTURE_VIEW_SIZE  ImVec2(300, 300) // Size of the texture view in pixels
+#include "reflective_json.h"
+#include "reflective_json_hotreload.h"
+#include "texture_generator.h"
+#include "example_app.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "alloc_counter.h"
 
 static void glfw_error_callback( int error, const char* description )
 {
     fprintf( stderr, "GLFW Error %d: %s\n", error, description );
 }
 
-GLuint GenerateCheckerTexture(int color)
+// Texture pool hooks for TextureGen: RGBA8 storage is allocated once per texture object and refilled on upload.
+static ImTextureID CreatePoolTexture( int width, int height, TextureGen::TextureFormat, void* )
 {
-    const int size = 164;
-    auto* pixels = new unsigned char[size * size * 4];
-
-    for (int y = 0; y < size; ++y)
-    {
-        for (int x = 0; x < size; ++x)
-        {
-            int i = (y * size + x) * 4;
-            bool checker = ((x / 8) % 2) ^ ((y / 8) % 2);
-            unsigned char c = checker ? color : 100;
-            pixels[i + 0] = c;
-            pixels[i + 1] = c;
-            pixels[i + 2] = c;
-            pixels[i + 3] = 255;
-        }
-    }
-
     GLuint texID;
-    glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0,
-                  GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    delete[] pixels;
-    return texID;
+    glGenTextures( 1, &texID );
+    glBindTexture( GL_TEXTURE_2D, texID );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    return ( ImTextureID )( uintptr_t )texID;
 }
 
-
-namespace ReflectiveJson
+static void UploadPoolTexture( ImTextureID texture, int width, int height, TextureGen::TextureFormat, const void* pixels, void* )
 {
-   
-
-    // ---------- Type name helper ----------
-    template<typename T>
-    std::string getTypeName()
-    {
-        std::string raw = typeid(T).name();
-        #if defined(__clang__) || defined(__GNUC__)
-        int status;
-        char* demangled = abi::__cxa_demangle( raw.c_str(), nullptr, nullptr, &status );
-        std::string result = (status == 0) ? demangled : raw;
-        std::free( demangled );
-        return result;
-        #else
-        if( raw.rfind( "struct ", 0 ) == 0 ) return raw.substr( 7 );
-        if( raw.rfind( "class ", 0 ) == 0 ) return raw.substr( 6 );
-        return raw;
-        #endif
-    }
-
-    // ---------- Reflection checker ----------
-    template<typename T>
-    concept HasGetFields = requires { T::getFields(); };
-
-    template<typename T>
-    constexpr bool has_getFields_v = HasGetFields<T>;
-
-    // ---------- FieldInfo ----------
-    template<typename T>
-    struct FieldInfo
-    {
-        const char* name;
-        std::string typeName;
-        std::function<std::string( const T& )> getter;
-        std::function<void( T& )> drawGui;
-        std::optional<std::pair<int, int>> intRange = std::nullopt;
-        std::optional<std::pair<float, float>> floatRange = std::nullopt;
-    };
-
-    // ---------- Macros simplificadas ----------
-    #define RTTI_FIELDS_BEGIN(CLASS) \
-    static const std::vector<ReflectiveJson::FieldInfo<CLASS>>& getFields() { \
-        using CurrentClass = CLASS; \
-        static const std::vector<ReflectiveJson::FieldInfo<CLASS>> fields = {
-
-    #define RTTI_FIELDS_END() \
-        }; return fields; }
-
-    #define RTTI_FIELD(FIELD) \
-    ReflectiveJson::FieldInfo<CurrentClass>{ \
-        #FIELD, \
-        ReflectiveJson::getTypeName<decltype(CurrentClass::FIELD)>(), \
-        [](const CurrentClass& self) { \
-            using FieldType = decltype(self.FIELD); \
-            if constexpr (std::is_same_v<FieldType, bool>) \
-                return self.FIELD ? "true" : "false"; \
-            else if constexpr (std::is_same_v<FieldType, std::string>) \
-                return "\"" + self.FIELD + "\""; \
-            else if constexpr (std::is_arithmetic_v<FieldType>) \
-                return std::to_string(self.FIELD); \
-            else \
-                return "{object}"; \
-        }, \
-        [](CurrentClass& self) { \
-            ImGui::PushID(#FIELD); \
-            using FieldType = decltype(self.FIELD); \
-            if constexpr (ReflectiveJson::has_getFields_v<FieldType>) { \
-                if (ImGui::CollapsingHeader(#FIELD)) \
-                    ReflectiveJson::DrawImGui(self.FIELD, true); \
-            } else if constexpr (std::is_same_v<FieldType, int>) { \
-                ImGui::DragInt(#FIELD, &self.FIELD); \
-            } else if constexpr (std::is_same_v<FieldType, float>) { \
-                ImGui::DragFloat(#FIELD, &self.FIELD, 0.1f); \
-            } else if constexpr (std::is_same_v<FieldType, bool>) { \
-                ImGui::Checkbox(#FIELD, &self.FIELD); \
-            } else if constexpr (std::is_same_v<FieldType, ImVec2>) { \
-                ImGui::DragFloat2(#FIELD, (float*)&self.FIELD); \
-            } else if constexpr (std::is_same_v<FieldType, ImVec4>) { \
-                ImGui::ColorEdit4(#FIELD, (float*)&self.FIELD, \
-                    ImGuiColorEditFlags_DisplayRGB | \
-                    ImGuiColorEditFlags_PickerHueBar | \
-                    ImGuiColorEditFlags_AlphaBar); \
-            } else if constexpr (std::is_same_v<FieldType, ImTextureID>) { \
-                ImGui::Text("%s", #FIELD); \
-                if (self.FIELD) { \
-                    ImGui::Image(self.FIELD, TEXTURE_VIEW_SIZE); \
-                } else { \
-                    ImGui::TextDisabled("Texture not visible or null"); \
-                } \
-            } else if constexpr (std::is_same_v<FieldType, std::string>) { \
-                char buffer[256]; \
-                strncpy(buffer, self.FIELD.c_str(), sizeof(buffer)); \
-                buffer[sizeof(buffer) - 1] = '\0'; \
-                if (ImGui::InputText(#FIELD, buffer, sizeof(buffer))) { \
-                    self.FIELD = buffer; \
-                } \
-            } \
-            ImGui::PopID(); \
-        } \
-    }
-
-
-    #define RTTI_FIELD_WITH_RANGE(FIELD, MIN, MAX) \
-    ReflectiveJson::FieldInfo<CurrentClass>{ \
-        #FIELD, \
-        ReflectiveJson::getTypeName<decltype(CurrentClass::FIELD)>(), \
-        [](const CurrentClass& self) { return std::to_string(self.FIELD); }, \
-        [](CurrentClass& self) { \
-            ImGui::PushID(#FIELD); \
-            if constexpr (std::is_same_v<decltype(self.FIELD), int>) { \
-                ImGui::SliderInt(#FIELD, &self.FIELD, MIN, MAX); \
-            } else if constexpr (std::is_same_v<decltype(self.FIELD), float>) { \
-                ImGui::SliderFloat(#FIELD, &self.FIELD, MIN, MAX); \
-            } else { \
-                ImGui::Text("Unsupported ranged type"); \
-            } \
-            ImGui::PopID(); \
-        }, \
-        std::is_same_v<decltype(CurrentClass::FIELD), int> ? std::make_optional(std::make_pair(MIN, MAX)) : std::nullopt, \
-        std::is_same_v<decltype(CurrentClass::FIELD), float> ? std::make_optional(std::make_pair(MIN, MAX)) : std::nullopt \
-    }
-
-    // ---------- ImGui drawer ----------
-    template<typename T>
-    void DrawImGui( T& obj, bool skipHeader = false )
-    {
-        std::string label = ReflectiveJson::getTypeName<T>();
-        if( label.empty() ) label = "Unnamed";
-
-        std::string headerId = label + "##" + std::to_string( reinterpret_cast< uintptr_t >(&obj) );
-
-        if( skipHeader || ImGui::CollapsingHeader( headerId.c_str(), ImGuiTreeNodeFlags_DefaultOpen ) )
-        {
-            ImGui::PushID( &obj );
-            ImGui::Indent();
-            for( const auto& field : T::getFields() )
-            {
-                if( field.drawGui ) field.drawGui( obj );
-            }
-            ImGui::Unindent();
-            ImGui::PopID();
-        }
-    }
-
-    // ---------- JSON Serializer ----------
-    template<typename T>
-    json toJson( const T& obj )
-    {
-        json j;
-        j[ "type" ] = getTypeName<T>();
-        for( const auto& field : T::getFields() )
-        {
-            j[ field.name ][ "type" ] = field.typeName;
-            j[ field.name ][ "value" ] = field.getter( obj );
-        }
-        return j;
-    }
-} // namespace ReflectiveJson
-
-  // ---------- DrawImGui recursivo ----------
-
-
-//template<typename T>
-//void DrawImGui(T& obj) {
-//    const char* typeName = typeid(T).name(); 
-//    if (ImGui::CollapsingHeader(typeName)) {
-//        for (auto& field : T::getFields()) {
-//            if (field.drawGui)
-//                field.drawGui(obj);
-//        }
-//    }
-//}
-
-struct Stats
-{
-    int strength;
-    float agility;
-
-    RTTI_FIELDS_BEGIN( Stats )
-        RTTI_FIELD_WITH_RANGE( strength, 0, 100 ),
-        RTTI_FIELD_WITH_RANGE( agility, 0.0f, 10.0f )
-        RTTI_FIELDS_END()
-};
-
-struct Player
-{
-    std::string name;
-    bool alive;
-    Stats stats;
-
-    RTTI_FIELDS_BEGIN( Player )
-        RTTI_FIELD( name ),
-        RTTI_FIELD( alive ),
-        RTTI_FIELD( stats )
-        RTTI_FIELDS_END()
-};
-
-struct Specular
-{
-    float r;
-    float g;
-    float b;
-    int a;
-
-    RTTI_FIELDS_BEGIN( Specular )
-        RTTI_FIELD_WITH_RANGE( r, 0.0f, 1.0f ),
-        RTTI_FIELD_WITH_RANGE( g, 0.0f, 1.0f ),
-        RTTI_FIELD_WITH_RANGE( b, 0.0f, 1.0f )
-        RTTI_FIELDS_END()
-};
-
-struct Emissive
-{
-    float r;
-    float g;
-    float b;
-    int a;
-
-    RTTI_FIELDS_BEGIN( Emissive )
-        RTTI_FIELD_WITH_RANGE( r, 0.0f, 10.0f ),
-        RTTI_FIELD_WITH_RANGE( g, 0.0f, 10.0f ),
-        RTTI_FIELD_WITH_RANGE( b, 0.0f, 10.0f )
-        RTTI_FIELDS_END()
-};
-
-struct Roughness
-{
-    float value;
-
-    RTTI_FIELDS_BEGIN( Roughness )
-        RTTI_FIELD_WITH_RANGE( value, 0.0f, 1.0f )
-        RTTI_FIELDS_END()
-};
-
-struct Metallic
-{
-    float value;
-
-    RTTI_FIELDS_BEGIN( Metallic )
-        RTTI_FIELD_WITH_RANGE( value, 0.0f, 1.0f )
-        RTTI_FIELDS_END()
-};
+    glBindTexture( GL_TEXTURE_2D, ( GLuint )( uintptr_t )texture );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels );
+    ReflectiveJson::markTextureChanged( texture );     // its inspector thumbnail may show the old contents
+}
 
-struct Light
+static void DestroyPoolTexture( ImTextureID texture, void* )
 {
+    GLuint texID = ( GLuint )( uintptr_t )texture;
+    glDeleteTextures( 1, &texID );
+}
 
-    ImVec4 color;
-    float intensity;
-    RTTI_FIELDS_BEGIN( Light )
-        RTTI_FIELD( color ),
-        RTTI_FIELD_WITH_RANGE( intensity, 0.0f, 100.0f )
-        RTTI_FIELDS_END()
-};
-
-struct Material
+// Inspector thumbnails: the texture is read back once and box-filtered on the CPU (GL 1.1, no framebuffer objects).
+static ImTextureID CreateTextureThumbnail( ImTextureID source, int maxSize, void* )
 {
-    Specular specular;
-    Emissive emissive;
-    Roughness roughness;
-    Metallic metallic;
-    Player owner;
-
-    RTTI_FIELDS_BEGIN( Material )
-        RTTI_FIELD( specular ),
-        RTTI_FIELD( emissive ),
-        RTTI_FIELD( roughness ),
-        RTTI_FIELD( metallic ),
-        RTTI_FIELD( owner )
-        RTTI_FIELDS_END()
-};
-
+#if defined(IMGUI_IMPL_OPENGL_ES2) || defined(__EMSCRIPTEN__)
+    IM_UNUSED( source );
+    IM_UNUSED( maxSize );
+    return ImTextureID_Invalid;     // no glGetTexImage(): the inspector draws the texture itself, small
+#else
+    GLint width = 0, height = 0;
+    glBindTexture( GL_TEXTURE_2D, ( GLuint )( uintptr_t )source );
+    glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width );
+    glGetTexLevelParameteriv( GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height );
+    if( width <= 0 || height <= 0 )
+        return ImTextureID_Invalid;
+    std::vector<unsigned char> pixels( ( size_t )width * height * 4 );
+    glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+    glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data() );
+
+    // Average of step x step source pixels per thumbnail pixel
+    const int step = ImMax( 1, (ImMax( width, height ) + maxSize - 1) / maxSize );
+    const int thumbWidth = ImMax( 1, width / step ), thumbHeight = ImMax( 1, height / step );
+    std::vector<unsigned char> thumb( ( size_t )thumbWidth * thumbHeight * 4 );
+    for( int y = 0; y < thumbHeight; y++ )
+        for( int x = 0; x < thumbWidth; x++ )
+            for( int c = 0; c < 4; c++ )
+            {
+                int sum = 0;
+                for( int sy = 0; sy < step; sy++ )
+                    for( int sx = 0; sx < step; sx++ )
+                        sum += pixels[ (( size_t )(y * step + sy) * width + (x * step + sx)) * 4 + c ];
+                thumb[ (( size_t )y * thumbWidth + x) * 4 + c ] = ( unsigned char )(sum / (step * step));
+            }
 
+    GLuint texID;
+    glGenTextures( 1, &texID );
+    glBindTexture( GL_TEXTURE_2D, texID );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, thumbWidth, thumbHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, thumb.data() );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+    return ( ImTextureID )( uintptr_t )texID;
+#endif
+}
 
-struct  GFrameBuffer
+static void DestroyTextureThumbnail( ImTextureID thumbnail, void* )
 {
-    ImTextureID positionTex;
-    ImTextureID normalTex;
-    ImTextureID depthTex;
-
-    RTTI_FIELDS_BEGIN( GFrameBuffer )
-        RTTI_FIELD( positionTex ),
-        RTTI_FIELD( normalTex ),
-        RTTI_FIELD( depthTex )
-        RTTI_FIELDS_END()
-
-
-};
-
-
-
-
-
-
-
+    GLuint texID = ( GLuint )( uintptr_t )thumbnail;
+    glDeleteTextures( 1, &texID );
+}
 
 
 // Main code
@@ -379,8 +130,10 @@ int main( int, char** )
 
     //Player player;
 
-    Material material{};
-    Light    light{};
+    // Everything the windows show and edit; the same scene is drawn headless by bench_replay
+    ExampleApp::Scene scene;
+    scene.patchOutput = stdout;
+    scene.fontPath = "../../misc/fonts/Roboto-Medium.ttf";
     //auto j =  ReflectiveJson::toJson( material );
     // std::cout << j.dump(4) << std::endl; // bonito con indentación
     //
@@ -433,6 +186,7 @@ int main( int, char** )
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
+    AllocCounter::InstallImGuiAllocator();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); ( void )io;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
@@ -466,14 +220,12 @@ int main( int, char** )
     //io.Fonts->AddFontDefault();
     //io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\segoeui.ttf");
     //io.Fonts->AddFontFromFileTTF("../../misc/fonts/DroidSans.ttf");
-    io.Fonts->AddFontFromFileTTF( "../../misc/fonts/Roboto-Medium.ttf" );
+    io.Fonts->AddFontFromFileTTF( scene.fontPath.c_str() );
     //io.Fonts->AddFontFromFileTTF("../../misc/fonts/Cousine-Regular.ttf");
     //ImFont* font = io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ArialUni.ttf");
     //IM_ASSERT(font != nullptr);
     // Our state
-    bool show_demo_window = false;
-    bool show_another_window = false;
-    ImVec4 clear_color = ImVec4( 0.45f, 0.55f, 0.60f, 1.00f );
+    ImVec4& clear_color = scene.clearColor;
 
     style = ImGui::GetStyle();
     main_scale = 1.2f; // You can adjust this value for bigger/smaller UI
@@ -487,11 +239,36 @@ int main( int, char** )
     EMSCRIPTEN_MAINLOOP_BEGIN
         #else
 
-    //Simulate a texture for demonstration purposes
-    GFrameBuffer gFrameBuffer;
-    gFrameBuffer.positionTex = (ImTextureID)(uintptr_t)GenerateCheckerTexture(255);
-    gFrameBuffer.normalTex = (ImTextureID)(uintptr_t)GenerateCheckerTexture(123);
-    gFrameBuffer.depthTex = (ImTextureID)(uintptr_t)GenerateCheckerTexture(22);
+    // 'scene.light' belongs to a simulation thread that keeps rotating its hue; the UI only sees published snapshots
+    std::atomic<bool> simulationRunning{ true };
+    std::thread simulationThread( [&]()
+    {
+        while( simulationRunning.load( std::memory_order_relaxed ) )
+        {
+            scene.stepLight();
+            std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+        }
+    } );
+
+    // material.json is watched: saving it in an editor applies the fields that changed at the start of the next frame
+    if( !std::filesystem::exists( "material.json" ) )
+    {
+        std::ofstream file( "material.json" );
+        ReflectiveJson::dumpJson( scene.material, file, 4 );
+    }
+    ReflectiveJson::HotReloader hotReloader;
+    hotReloader.watch( "material.json", scene.material );
+    hotReloader.start();
+
+    // Texture fields are previewed through small thumbnails made on first display
+    ReflectiveJson::textureThumbnailer = { CreateTextureThumbnail, DestroyTextureThumbnail, nullptr };
+
+    //Simulate a texture for demonstration purposes: generated on the thread pool, uploaded by textures.update()
+    TextureGen::TextureGenerator textures( { CreatePoolTexture, UploadPoolTexture, DestroyPoolTexture, nullptr } );
+    GFrameBuffer& gFrameBuffer = scene.frameBuffer;
+    gFrameBuffer.positionTex = textures.request( TextureGen::TextureDesc::Checker( 164, 164, 8, IM_COL32( 100, 100, 100, 255 ), IM_COL32( 255, 255, 255, 255 ) ) );
+    gFrameBuffer.normalTex = textures.request( TextureGen::TextureDesc::Checker( 164, 164, 8, IM_COL32( 100, 100, 100, 255 ), IM_COL32( 123, 123, 123, 255 ) ) );
+    gFrameBuffer.depthTex = textures.request( TextureGen::TextureDesc::Checker( 164, 164, 8, IM_COL32( 100, 100, 100, 255 ), IM_COL32( 22, 22, 22, 255 ) ) );
     while( !glfwWindowShouldClose( window ) )
         #endif
     {
@@ -507,100 +284,19 @@ int main( int, char** )
             continue;
         }
 
+        // Count heap allocations from here to the start of the next frame
+        scene.lastFrameAllocs = AllocCounter::GetFrameStats();
+        AllocCounter::BeginFrame();
+
         // Start the Dear ImGui frame
+        textures.update( 8 );      // a few uploads per frame at most
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
+        scene.inputRecorder.captureFrame(); // after the backend queued this frame's events, for bench_replay
         ImGui::NewFrame();
+        hotReloader.applyPending();
 
-        // 1. Show the big demo window (Most of the sample code is in ImGui::ShowDemoWindow()! You can browse its code to learn more about Dear ImGui!).
-        if( show_demo_window )
-            ImGui::ShowDemoWindow( &show_demo_window );
-
-        //Albedo albedo{};
-        ReflectiveJson::DrawImGui( material ); 
-        Stats stats{};
-        ReflectiveJson::DrawImGui( stats ); 
-
-        ReflectiveJson::DrawImGui( light ); 
-
-        ReflectiveJson::DrawImGui( gFrameBuffer ); 
-
-      
-
-        // 2. Show a simple window that we create ourselves. We use a Begin/End pair to create a named window.
-        {
-            static float f = 0.0f;
-            static int counter = 0;
-
-            ImGui::Begin( "Hello, world!" );                          // Create a window called "Hello, world!" and append into it.
-
-            ImGui::Text( "This is some useful text." );               // Display some text (you can use a format strings too)
-            ImGui::Checkbox( "Demo Window", &show_demo_window );      // Edit bools storing our window open/close state
-            ImGui::Checkbox( "Another Window", &show_another_window );
-
-            ImGui::SliderFloat( "float", &f, 0.0f, 1.0f );            // Edit 1 float using a slider from 0.0f to 1.0f
-            ImGui::ColorEdit3( "clear color", ( float* )&clear_color ); // Edit 3 floats representing a color
-
-            if( ImGui::Button( "Button" ) )                            // Buttons return true when clicked (most widgets return true when edited/activated)
-                counter++;
-            ImGui::SameLine();
-            ImGui::Text( "counter = %d", counter );
-
-            ImGui::Text( "Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate );
-
-
-
-            // Define the component state
-            struct MyComponent
-            {
-                char text[ 128 ] = "";
-                int combo_current = 0;
-                bool submitted = false;
-            };
-
-            // Place these static variables at the top of your main loop (inside ImGui::Begin)
-            static std::vector<MyComponent> components;
-            static const char* combo_items[] = { "Option 1", "Option 2", "Option 3" };
-
-            // Button to add a new component
-            if( ImGui::Button( "Add Component" ) )
-            {
-                components.push_back( MyComponent() );
-            }
-
-            // Render all components
-            for( size_t i = 0; i < components.size(); ++i )
-            {
-                ImGui::Separator();
-                ImGui::Text( "Component #%zu", i + 1 );
-
-                ImGui::InputText( ("Text##" + std::to_string( i )).c_str(), components[ i ].text, IM_ARRAYSIZE( components[ i ].text ) );
-                ImGui::Combo( ("Combo##" + std::to_string( i )).c_str(), &components[ i ].combo_current, combo_items, IM_ARRAYSIZE( combo_items ) );
-
-                if( ImGui::Button( ("Submit##" + std::to_string( i )).c_str() ) )
-                {
-                    components[ i ].submitted = true;
-                    printf( "Component %zu: Text='%s', Combo='%s'\n", i + 1, components[ i ].text, combo_items[ components[ i ].combo_current ] );
-                }
-                if( components[ i ].submitted )
-                    ImGui::TextColored( ImVec4( 0, 1, 0, 1 ), "Submitted!" );
-            }
-
-
-
-
-            ImGui::End();
-        }
-
-        // 3. Show another simple window.
-        if( show_another_window )
-        {
-            ImGui::Begin( "Another Window", &show_another_window );   // Pass a pointer to our bool variable (the window will have a closing button that will clear the bool when clicked)
-            ImGui::Text( "Hello from another window!" );
-            if( ImGui::Button( "Close Me" ) )
-                show_another_window = false;
-            ImGui::End();
-        }
+        ExampleApp::DrawReflectedWindows( scene );
 
         // Rendering
         ImGui::Render();
@@ -618,6 +314,12 @@ int main( int, char** )
     #endif
 
     // Cleanup
+    hotReloader.stop();
+    simulationRunning = false;
+    simulationThread.join();
+    scene.stopService();
+    ReflectiveJson::releaseTextureThumbnails();
+    textures.clear();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,148 @@
+// Reflected example types shown by the inspector (and reused by the headless benchmarks).
+
+#pragma once
+
+#include "reflective_json.h"
+
+struct Stats
+{
+    int strength;
+    float agility;
+
+    RTTI_FIELDS_BEGIN( Stats )
+        RTTI_FIELD_WITH_RANGE( strength, 0, 100 ),
+        RTTI_FIELD_WITH_RANGE( agility, 0.0f, 10.0f )
+        RTTI_FIELDS_END()
+};
+
+struct Player
+{
+    std::string name;
+    bool alive;
+    Stats stats;
+
+    RTTI_FIELDS_BEGIN( Player )
+        RTTI_FIELD( name ),
+        RTTI_FIELD( alive ),
+        RTTI_FIELD( stats )
+        RTTI_FIELDS_END()
+};
+
+struct Specular
+{
+    float r;
+    float g;
+    float b;
+    int a;
+
+    RTTI_FIELDS_BEGIN( Specular )
+        RTTI_FIELD_WITH_RANGE( r, 0.0f, 1.0f ),
+        RTTI_FIELD_WITH_RANGE( g, 0.0f, 1.0f ),
+        RTTI_FIELD_WITH_RANGE( b, 0.0f, 1.0f )
+        RTTI_FIELDS_END()
+};
+
+struct Emissive
+{
+    float r;
+    float g;
+    float b;
+    int a;
+
+    RTTI_FIELDS_BEGIN( Emissive )
+        RTTI_FIELD_WITH_RANGE( r, 0.0f, 10.0f ),
+        RTTI_FIELD_WITH_RANGE( g, 0.0f, 10.0f ),
+        RTTI_FIELD_WITH_RANGE( b, 0.0f, 10.0f )
+        RTTI_FIELDS_END()
+};
+
+struct Roughness
+{
+    float value;
+
+    RTTI_FIELDS_BEGIN( Roughness )
+        RTTI_FIELD_WITH_RANGE( value, 0.0f, 1.0f )
+        RTTI_FIELDS_END()
+};
+
+struct Metallic
+{
+    float value;
+
+    RTTI_FIELDS_BEGIN( Metallic )
+        RTTI_FIELD_WITH_RANGE( value, 0.0f, 1.0f )
+        RTTI_FIELDS_END()
+};
+
+struct Light
+{
+
+    ImVec4 color;
+    float intensity;
+    RTTI_FIELDS_BEGIN( Light )
+        RTTI_FIELD( color ),
+        RTTI_FIELD_WITH_RANGE( intensity, 0.0f, 100.0f )
+        RTTI_FIELDS_END()
+};
+
+struct Material
+{
+    Specular specular;
+    Emissive emissive;
+    Roughness roughness;
+    Metallic metallic;
+    Player owner;
+
+    RTTI_FIELDS_BEGIN( Material )
+        RTTI_FIELD( specular ),
+        RTTI_FIELD( emissive ),
+        RTTI_FIELD( roughness ),
+        RTTI_FIELD( metallic ),
+        RTTI_FIELD( owner )
+        RTTI_FIELDS_END()
+};
+
+
+
+// Large collections: drawn as virtualized tables, only the visible rows are submitted.
+struct Squad
+{
+    std::string name;
+    std::vector<Stats> members;
+    std::vector<float> weights;
+
+    RTTI_FIELDS_BEGIN( Squad )
+        RTTI_FIELD( name ),
+        RTTI_FIELD( members ),
+        RTTI_FIELD( weights )
+        RTTI_FIELDS_END()
+};
+
+// Sensor buffers: large float arrays are drawn as min/max sparklines (wheel to zoom, drag to pan).
+struct SensorTrace
+{
+    std::string name;
+    std::vector<float> samples;
+    float recent[ 512 ];
+
+    RTTI_FIELDS_BEGIN( SensorTrace )
+        RTTI_FIELD( name ),
+        RTTI_FIELD( samples ),
+        RTTI_FIELD( recent )
+        RTTI_FIELDS_END()
+};
+
+struct  GFrameBuffer
+{
+    ImTextureID positionTex;
+    ImTextureID normalTex;
+    ImTextureID depthTex;
+
+    RTTI_FIELDS_BEGIN( GFrameBuffer )
+        RTTI_FIELD( positionTex ),
+        RTTI_FIELD( normalTex ),
+        RTTI_FIELD( depthTex )
+        RTTI_FIELDS_END()
+
+
+};
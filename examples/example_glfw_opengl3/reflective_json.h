@@ -0,0 +1,1305 @@
+// ReflectiveJson: minimal compile-time reflection for plain structs, with an ImGui inspector and a JSON dump.
+//
+// A reflected struct lists its members once with RTTI_FIELDS_BEGIN / RTTI_FIELD / RTTI_FIELDS_END.
+// That produces two views of the same list:
+// - fieldDescs(): a constexpr std::tuple of FieldDesc (member pointer + metadata). DrawImGui() and toJson()
+//   walk it with fold expressions, so every field is a direct, inlinable call with no heap storage.
+// - getFields(): a type-erased std::vector<FieldInfo<T>> built once from fieldDescs(), for code that needs
+//   to iterate fields at runtime (by index, by name, ...). DrawImGuiTable() draws through it.
+//   Each FieldInfo also carries a FieldMeta (kind, byte offset, range), and getTypeMeta<T>() exposes the
+//   table without the T parameter so loaders can walk nested objects through a void*.
+//
+// A C array member of bool/int/float (float history[ 512 ]) is drawn read-only, as a sparkline for float, and goes
+// through dumpJson()/fromJson() and the binary formats as a JSON array. Its FieldMeta kind stays Unsupported: records,
+// scene files, patches, the snapshot bridge and hot reload skip it.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "misc/cpp/imgui_stdlib.h"
+#include <json.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+
+#define TEXTURE_VIEW_SIZE  ImVec2(300, 300) // Size of the texture view in pixels
+
+namespace ReflectiveJson
+{
+    // ---------- Type name helper ----------
+    // Type names are extracted at compile time from the compiler's pretty function signature, so they cost
+    // nothing at runtime (no typeid, no __cxa_demangle, no allocation). The returned view is null-terminated.
+    namespace detail
+    {
+        template<typename T>
+        constexpr std::string_view rawFunctionSignature()
+        {
+            #if defined(_MSC_VER) && !defined(__clang__)
+            return __FUNCSIG__;
+            #else
+            return __PRETTY_FUNCTION__;
+            #endif
+        }
+
+        // Probe with a known type to find how much of the signature surrounds the type name.
+        constexpr std::string_view probeSignature = rawFunctionSignature<int>();
+        constexpr std::size_t signaturePrefix = probeSignature.find( "int" );
+        constexpr std::size_t signatureSuffix = probeSignature.size() - signaturePrefix - 3;
+
+        template<typename T>
+        constexpr std::string_view extractTypeName()
+        {
+            std::string_view name = rawFunctionSignature<T>();
+            name = name.substr( signaturePrefix, name.size() - signaturePrefix - signatureSuffix );
+            #if defined(_MSC_VER) && !defined(__clang__)
+            if( name.starts_with( "struct " ) ) name.remove_prefix( 7 );
+            else if( name.starts_with( "class " ) ) name.remove_prefix( 6 );
+            else if( name.starts_with( "enum " ) ) name.remove_prefix( 5 );
+            #endif
+            return name;
+        }
+
+        template<typename T>
+        struct TypeNameStorage
+        {
+            static constexpr std::string_view view = extractTypeName<T>();
+            static constexpr std::array<char, view.size() + 1> chars = []()
+            {
+                std::array<char, view.size() + 1> result{};
+                for( std::size_t i = 0; i < view.size(); i++ )
+                    result[ i ] = view[ i ];
+                return result;
+            }();
+        };
+    } // namespace detail
+
+    template<typename T>
+    constexpr std::string_view getTypeName()
+    {
+        using Storage = detail::TypeNameStorage<std::remove_cv_t<T>>;
+        return std::string_view( Storage::chars.data(), Storage::view.size() );
+    }
+
+    // Interned per-type data used every frame by the inspector.
+    struct TypeInfo
+    {
+        std::string_view name;  // == getTypeName<T>(), never empty ("Unnamed" fallback)
+        ImGuiID id;             // == ImHashStr(name)
+    };
+
+    template<typename T>
+    const TypeInfo& getTypeInfo()
+    {
+        static const TypeInfo info = []()
+        {
+            std::string_view name = getTypeName<T>();
+            if( name.empty() ) name = "Unnamed";
+            return TypeInfo{ name, ImHashStr( name.data(), name.size() ) };
+        }();
+        return info;
+    }
+
+    // ---------- Reflection checker ----------
+    template<typename T>
+    concept HasGetFields = requires { T::getFields(); };
+
+    template<typename T>
+    constexpr bool has_getFields_v = HasGetFields<T>;
+
+    // ---------- FieldDesc (compile-time descriptor) ----------
+    template<typename C, typename M>
+    struct FieldDesc
+    {
+        using Class = C;
+        using Member = M;
+
+        const char* name;
+        M C::* member;
+        bool hasRange = false;
+        double rangeMin = 0.0;
+        double rangeMax = 0.0;
+    };
+
+    template<typename C, typename M>
+    constexpr FieldDesc<C, M> makeField( const char* name, M C::* member )
+    {
+        return FieldDesc<C, M>{ name, member };
+    }
+
+    template<typename C, typename M>
+    constexpr FieldDesc<C, M> makeField( const char* name, M C::* member, double rangeMin, double rangeMax )
+    {
+        return FieldDesc<C, M>{ name, member, true, rangeMin, rangeMax };
+    }
+
+    // Calls f(desc) for every field of T, in declaration order, unrolled at compile time.
+    template<typename T, typename F>
+    constexpr void forEachField( F&& f )
+    {
+        std::apply( [&]( const auto&... desc ) { (f( desc ), ...); }, T::fieldDescs() );
+    }
+
+    template<typename T>
+    constexpr std::size_t fieldCount()
+    {
+        return std::tuple_size_v<decltype(T::fieldDescs())>;
+    }
+
+    // Same as forEachField(), calling f(desc, index) with the field's position in the table.
+    template<typename T, typename F>
+    constexpr void forEachFieldIndexed( F&& f )
+    {
+        [&]<std::size_t... I>( std::index_sequence<I...> )
+        {
+            constexpr auto descs = T::fieldDescs();
+            (f( std::get<I>( descs ), I ), ...);
+        }( std::make_index_sequence<fieldCount<T>()>{} );
+    }
+
+    template<typename T>
+    struct is_std_vector : std::false_type {};
+
+    template<typename E>
+    struct is_std_vector<std::vector<E>> : std::true_type {};
+
+    template<typename T>
+    constexpr bool is_std_vector_v = is_std_vector<T>::value;
+
+    // ---------- FieldMeta (type-erased layout) ----------
+    // What code that only has a void* and a field name/index needs: kind, byte offset, size and range.
+    enum class FieldKind
+    {
+        Unsupported,
+        Bool,       // bool
+        Int,        // int
+        Float,      // float
+        String,     // std::string
+        Vec2,       // ImVec2
+        Vec4,       // ImVec4
+        Texture,    // ImTextureID
+        Object,     // reflected struct, see FieldMeta::nested
+        Vector,     // std::vector<E> of any of the above, see FieldMeta::element
+    };
+
+    template<typename M>
+    constexpr FieldKind fieldKindOf()
+    {
+        if constexpr( has_getFields_v<M> )                  return FieldKind::Object;
+        else if constexpr( std::is_same_v<M, bool> )        return FieldKind::Bool;
+        else if constexpr( std::is_same_v<M, int> )         return FieldKind::Int;
+        else if constexpr( std::is_same_v<M, float> )       return FieldKind::Float;
+        else if constexpr( std::is_same_v<M, std::string> ) return FieldKind::String;
+        else if constexpr( std::is_same_v<M, ImVec2> )      return FieldKind::Vec2;
+        else if constexpr( std::is_same_v<M, ImVec4> )      return FieldKind::Vec4;
+        else if constexpr( std::is_same_v<M, ImTextureID> ) return FieldKind::Texture;
+        else if constexpr( is_std_vector_v<M> )             return FieldKind::Vector;
+        else                                                return FieldKind::Unsupported;
+    }
+
+    struct TypeMeta;
+
+    // Erased access to a std::vector<E> member, plus what the elements are.
+    struct VectorMeta
+    {
+        FieldKind elementKind;
+        std::size_t elementSize;
+        const TypeMeta* elementNested;                  // elementKind == FieldKind::Object
+        std::size_t( *size )(const void* vec);
+        void( *resize )(void* vec, std::size_t count);
+        void* ( *at )(void* vec, std::size_t index);
+        void( *assign )(void* dst, const void* src);                           // *dst = *src
+        void( *copyElement )(void* dst, const void* src, std::size_t index);    // (*dst)[ index ] = (*src)[ index ]
+
+        const void* at_const( const void* vec, std::size_t index ) const { return at( const_cast< void* >(vec), index ); }
+    };
+
+    struct FieldMeta
+    {
+        const char* name = nullptr;
+        std::string_view typeName;
+        FieldKind kind = FieldKind::Unsupported;
+        std::size_t offset = 0;                 // Byte offset of the member inside its owner
+        std::size_t size = 0;                   // sizeof(member)
+        const TypeMeta* nested = nullptr;       // kind == FieldKind::Object: layout of the member type
+        const VectorMeta* element = nullptr;    // kind == FieldKind::Vector: element type and container access
+        FieldKind arrayElement = FieldKind::Unsupported;    // C array of bool/int/float: element kind and extent
+        std::size_t arrayCount = 0;
+        std::optional<std::pair<int, int>> intRange = std::nullopt;
+        std::optional<std::pair<float, float>> floatRange = std::nullopt;
+
+        void* ptr( void* owner ) const                  { return static_cast< char* >(owner) + offset; }
+        const void* ptr( const void* owner ) const      { return static_cast< const char* >(owner) + offset; }
+    };
+
+    // Decoded number -> int / float member, for the loaders. A double outside the range of the target type is
+    // undefined behaviour to convert, so it is clamped first: to the field's RTTI_FIELD_WITH_RANGE range, otherwise to
+    // the limits of the type. 'field' is null for std::vector elements.
+    inline bool numberToInt( double value, const FieldMeta* field, int& out )
+    {
+        if( std::isnan( value ) )
+            return false;       // no meaningful int: the member keeps its value
+        const double lo = field && field->intRange ? ( double )field->intRange->first : ( double )INT_MIN;
+        const double hi = field && field->intRange ? ( double )field->intRange->second : ( double )INT_MAX;
+        out = ( int )ImClamp( value, lo, hi );
+        return true;
+    }
+
+    inline float numberToFloat( double value, const FieldMeta* field )
+    {
+        if( std::isnan( value ) )
+            return ( float )value;
+        if( field && field->floatRange )
+            return ( float )ImClamp( value, ( double )field->floatRange->first, ( double )field->floatRange->second );
+        return std::isinf( value ) ? ( float )value : ( float )ImClamp( value, -( double )FLT_MAX, ( double )FLT_MAX );
+    }
+
+    // Erased view over T::getFields(), shared by every T. See getTypeMeta<T>().
+    struct TypeMeta
+    {
+        std::string_view name;
+        std::size_t size = 0;
+        std::vector<const FieldMeta*> fields;
+        ImGuiID schemaHash = 0;                 // See computeSchemaHash()
+
+        const FieldMeta* findField( std::string_view fieldName ) const
+        {
+            for( const FieldMeta* field : fields )
+                if( fieldName == field->name )
+                    return field;
+            return nullptr;
+        }
+    };
+
+    // Hash of the type name and of every field name and type, in order: two types with the same hash have the same
+    // fields. Leaf types are hashed by FieldKind (compiler-independent, unlike getTypeName() of std::string),
+    // reflected members and std::vector elements by their type name.
+    inline ImGuiID computeSchemaHash( const TypeMeta& type )
+    {
+        ImGuiID hash = ImHashStr( type.name.data(), type.name.size() );
+        for( const FieldMeta* field : type.fields )
+        {
+            hash = ImHashStr( field->name, 0, hash );
+            hash = ImHashData( &field->kind, sizeof( field->kind ), hash );
+            if( field->nested )
+                hash = ImHashStr( field->nested->name.data(), field->nested->name.size(), hash );
+            if( field->element )
+            {
+                hash = ImHashData( &field->element->elementKind, sizeof( field->element->elementKind ), hash );
+                if( field->element->elementNested )
+                    hash = ImHashStr( field->element->elementNested->name.data(), field->element->elementNested->name.size(), hash );
+            }
+        }
+        return hash;
+    }
+
+    // ---------- FieldInfo (type-erased runtime table) ----------
+    template<typename T>
+    struct FieldInfo : FieldMeta
+    {
+        std::function<std::string( const T& )> getter;
+        std::function<bool( T& )> drawGui;      // Returns true when the user edited the value
+    };
+
+    template<typename T>
+    const TypeMeta& getTypeMeta();
+
+    template<typename E>
+    const VectorMeta& getVectorMeta()
+    {
+        static const VectorMeta meta = []()
+        {
+            VectorMeta result{};
+            result.elementKind = fieldKindOf<E>();
+            result.elementSize = sizeof( E );
+            if constexpr( has_getFields_v<E> )
+                result.elementNested = &getTypeMeta<E>();
+            result.size = []( const void* vec ) { return static_cast< const std::vector<E>* >(vec)->size(); };
+            result.resize = []( void* vec, std::size_t count ) { static_cast< std::vector<E>* >(vec)->resize( count ); };
+            result.at = []( void* vec, std::size_t index ) -> void* { return &(*static_cast< std::vector<E>* >(vec))[ index ]; };
+            result.assign = []( void* dst, const void* src ) { *static_cast< std::vector<E>* >(dst) = *static_cast< const std::vector<E>* >(src); };
+            result.copyElement = []( void* dst, const void* src, std::size_t index )
+            {
+                (*static_cast< std::vector<E>* >(dst))[ index ] = (*static_cast< const std::vector<E>* >(src))[ index ];
+            };
+            return result;
+        }();
+        return meta;
+    }
+
+    template<typename C, typename M>
+    std::size_t memberOffset( M C::* member )
+    {
+        // Computed on uninitialized storage: nothing is constructed or read.
+        alignas(C) static unsigned char storage[ sizeof( C ) ];
+        const C* obj = reinterpret_cast< const C* >(storage);
+        return ( std::size_t )(reinterpret_cast< const unsigned char* >(&(obj->*member)) - storage);
+    }
+
+    // ---------- Macros simplificadas ----------
+    #define RTTI_FIELDS_BEGIN(CLASS) \
+    using RttiClass = CLASS; \
+    static constexpr auto fieldDescs() { \
+        using CurrentClass = CLASS; \
+        return std::make_tuple(
+
+    #define RTTI_FIELDS_END() \
+        ); } \
+    static const std::vector<ReflectiveJson::FieldInfo<RttiClass>>& getFields() { \
+        static const std::vector<ReflectiveJson::FieldInfo<RttiClass>> fields = ReflectiveJson::makeFieldTable<RttiClass>(); \
+        return fields; }
+
+    #define RTTI_FIELD(FIELD) \
+    ReflectiveJson::makeField( #FIELD, &CurrentClass::FIELD )
+
+    #define RTTI_FIELD_WITH_RANGE(FIELD, MIN, MAX) \
+    ReflectiveJson::makeField( #FIELD, &CurrentClass::FIELD, MIN, MAX )
+
+    // Flags used for the CollapsingHeader of nested reflected objects (e.g. ImGuiTreeNodeFlags_DefaultOpen).
+    inline ImGuiTreeNodeFlags nestedHeaderFlags = ImGuiTreeNodeFlags_None;
+
+    // ---------- Change tracking ----------
+    // DrawImGui() returns a FieldMask: bit i is set when field i of the object (or anything inside it, for a nested
+    // object) was edited during the call. Up to 64 fields per struct.
+    using FieldMask = std::uint64_t;
+
+    struct FieldChange
+    {
+        json::json_pointer path;        // e.g. "/owner/stats/strength", "/weights/12"
+        std::size_t offset;             // Byte offset of the edited member from the root object
+        const FieldMeta* field;         // Edited leaf field
+        std::size_t elementIndex;       // field->kind == FieldKind::Vector: edited element, else npos
+
+        static constexpr std::size_t npos = ( std::size_t )-1;
+    };
+
+    // Called for every edit of a leaf, on every frame it changes (also when it is already listed), with the leaf
+    // value before and after the widget ran. 'change.path' is left empty; 'before' is null if it was not captured.
+    using EditObserver = void( * )( void* user, void* root, const FieldChange& change, const void* before, const void* after );
+
+    // Leaf fields edited through DrawImGui( obj, changes ), each listed once, in first-edit order.
+    // Accumulates across frames until clear(): collect edits, send them (see makeJsonPatch()), clear.
+    struct ChangeList
+    {
+        std::vector<FieldChange> changes;
+        EditObserver observer = nullptr;        // optional, see UndoJournal
+        void* observerUser = nullptr;
+
+        bool empty() const  { return changes.empty(); }
+        void clear()        { changes.clear(); }
+    };
+
+    // Size of a trivially copyable leaf kind, 0 for the others.
+    inline std::size_t leafSize( FieldKind kind )
+    {
+        switch( kind )
+        {
+        case FieldKind::Bool:       return sizeof( bool );
+        case FieldKind::Int:        return sizeof( int );
+        case FieldKind::Float:      return sizeof( float );
+        case FieldKind::Vec2:       return sizeof( ImVec2 );
+        case FieldKind::Vec4:       return sizeof( ImVec4 );
+        case FieldKind::Texture:    return sizeof( ImTextureID );
+        default:                    return 0;
+        }
+    }
+
+    // Leaf addressed by a FieldChange-like (offset, field, elementIndex) inside 'root', and its kind.
+    // nullptr if the vector element no longer exists.
+    inline void* leafPtr( void* root, std::size_t offset, const FieldMeta* field, std::size_t elementIndex, FieldKind& kind )
+    {
+        void* member = static_cast< char* >(root) + offset;
+        kind = field->kind;
+        if( elementIndex == FieldChange::npos )
+            return member;
+        const VectorMeta* element = field->element;
+        if( !element || elementIndex >= element->size( member ) )
+            return nullptr;
+        kind = element->elementKind;
+        return element->at( member, elementIndex );
+    }
+
+    namespace detail
+    {
+        // Active while DrawImGui( obj, changes ) runs: where to record, and the path of nested field names.
+        struct ChangeRecorder
+        {
+            ChangeList* list = nullptr;
+            void* root = nullptr;
+            const char* path[ 16 ] = {};
+            int depth = 0;
+        };
+        inline ChangeRecorder changeRecorder;
+
+        // True when edits should be reported with their previous value.
+        inline bool observingEdits()
+        {
+            return changeRecorder.list && changeRecorder.list->observer;
+        }
+
+        // 'value' is the member; 'leaf' the edited value (the member, or the element for vectors).
+        template<typename C>
+        void recordChange( const char* name, const void* value, std::size_t elementIndex = FieldChange::npos,
+            const void* before = nullptr, const void* leaf = nullptr )
+        {
+            ChangeRecorder& rec = changeRecorder;
+            if( rec.list == nullptr )
+                return;
+
+            const std::size_t offset = ( std::size_t )(static_cast< const char* >(value) - static_cast< const char* >(rec.root));
+            if( rec.list->observer )
+            {
+                const FieldChange edit{ json::json_pointer(), offset, getTypeMeta<C>().findField( name ), elementIndex };
+                rec.list->observer( rec.list->observerUser, rec.root, edit, before, leaf ? leaf : value );
+            }
+            for( const FieldChange& change : rec.list->changes )
+                if( change.offset == offset && change.elementIndex == elementIndex )
+                    return;
+
+            json::json_pointer path;
+            for( int i = 0; i < rec.depth; i++ )
+                path /= rec.path[ i ];
+            path /= name;
+            if( elementIndex != FieldChange::npos )
+                path /= elementIndex;
+            rec.list->changes.push_back( FieldChange{ std::move( path ), offset, getTypeMeta<C>().findField( name ), elementIndex } );
+        }
+    } // namespace detail
+
+    template<typename T>
+    FieldMask DrawImGui( T& obj, bool skipHeader = false );
+
+    // Number of rows shown at once for std::vector fields (the rest is reached by scrolling).
+    inline int vectorVisibleRows = 10;
+
+    // ---------- Sparklines ----------
+    // std::vector<float> fields of at least sparklineMinCount elements, and float[N] fields, are drawn as a line plot
+    // of the min/max envelope of the data: one (min, max) pair per pixel column, read from a pyramid of block minima
+    // and maxima built once per data version. The mouse wheel zooms around the cursor, dragging pans, double-click
+    // shows everything again; once a column covers fewer than two samples the raw samples are plotted.
+    //
+    // The pyramid is rebuilt when the data changes address or size, when an element is edited in the inspector, when
+    // markDataChanged() is called for it, or when one of a few probed samples changes. Code that rewrites a few
+    // samples in place should call markDataChanged( values.data() ).
+    //
+    // The state of a sparkline (its pyramid, a decimated copy of the data) is dropped once it has not been drawn for
+    // sparklineKeepFrames frames, and so are data versions that nothing used for as long.
+    inline int sparklineMinCount = 1024;
+    inline float sparklineHeight = 60.0f;
+    inline int sparklineKeepFrames = 600;
+
+    namespace detail
+    {
+        struct Sparkline
+        {
+            static constexpr std::size_t BaseBlock = 16;    // samples per block in level 0, doubling at each level
+            static constexpr int ProbeCount = 32;
+
+            // What the pyramid was built from
+            const float* data = nullptr;
+            std::size_t count = 0;
+            std::uint64_t version = 0;
+            ImGuiID probe = 0;
+
+            std::vector<ImVec2> blocks;                 // (min, max) per block, all levels back to back
+            std::vector<std::size_t> levelStart;        // first block of each level in 'blocks'
+            double viewBegin = 0.0, viewEnd = 0.0;      // zoomed range in samples, viewEnd == 0 for everything
+            std::vector<float> plot;                    // values submitted to PlotLines()
+            int lastFrame = 0;                          // last ImGui frame it was drawn in
+        };
+
+        struct DataVersion
+        {
+            std::uint64_t version = 0;
+            int lastFrame = 0;                          // last frame it was bumped or read
+        };
+
+        inline std::unordered_map<ImGuiID, Sparkline>& sparklines()
+        {
+            static std::unordered_map<ImGuiID, Sparkline> states;
+            return states;
+        }
+
+        inline std::unordered_map<const void*, DataVersion>& dataVersions()
+        {
+            static std::unordered_map<const void*, DataVersion> versions;
+            return versions;
+        }
+
+        // Once per frame: drops the sparklines and data versions unused for sparklineKeepFrames frames.
+        inline void evictSparklines( int frame )
+        {
+            static int evictedFrame = -1;
+            if( evictedFrame == frame )
+                return;
+            evictedFrame = frame;
+            std::unordered_map<ImGuiID, Sparkline>& states = sparklines();
+            for( auto it = states.begin(); it != states.end(); )
+            {
+                if( frame - it->second.lastFrame > sparklineKeepFrames )
+                    it = states.erase( it );
+                else
+                    ++it;
+            }
+            std::unordered_map<const void*, DataVersion>& versions = dataVersions();
+            for( auto it = versions.begin(); it != versions.end(); )
+            {
+                if( frame - it->second.lastFrame > sparklineKeepFrames )
+                    it = versions.erase( it );
+                else
+                    ++it;
+            }
+        }
+
+        inline ImGuiID probeSamples( const float* values, std::size_t count )
+        {
+            ImGuiID hash = 0;
+            for( int i = 0; i < Sparkline::ProbeCount && count > 0; i++ )
+                hash = ImHashData( &values[ (count - 1) * i / (Sparkline::ProbeCount - 1) ], sizeof( float ), hash );
+            return hash;
+        }
+
+        inline void buildSparklinePyramid( Sparkline& s )
+        {
+            s.blocks.clear();
+            s.levelStart.clear();
+            s.levelStart.push_back( 0 );
+            for( std::size_t begin = 0; begin < s.count; begin += Sparkline::BaseBlock )
+            {
+                const std::size_t end = ImMin( begin + Sparkline::BaseBlock, s.count );
+                ImVec2 range( s.data[ begin ], s.data[ begin ] );
+                for( std::size_t i = begin + 1; i < end; i++ )
+                    range = ImVec2( ImMin( range.x, s.data[ i ] ), ImMax( range.y, s.data[ i ] ) );
+                s.blocks.push_back( range );
+            }
+            // Each level merges pairs of blocks of the previous one, down to a single block.
+            for( std::size_t prev = 0, prevCount = s.blocks.size(); prevCount > 1; prevCount = (prevCount + 1) / 2 )
+            {
+                s.levelStart.push_back( s.blocks.size() );
+                for( std::size_t i = 0; i < prevCount; i += 2 )
+                {
+                    const ImVec2 a = s.blocks[ prev + i ];
+                    const ImVec2 b = i + 1 < prevCount ? s.blocks[ prev + i + 1 ] : a;
+                    s.blocks.push_back( ImVec2( ImMin( a.x, b.x ), ImMax( a.y, b.y ) ) );
+                }
+                prev = s.levelStart.back();
+            }
+        }
+
+        // (min, max) of samples [begin, end), from the coarsest level whose blocks fit in the range.
+        inline ImVec2 sparklineRange( const Sparkline& s, std::size_t begin, std::size_t end, int level )
+        {
+            ImVec2 range( FLT_MAX, -FLT_MAX );
+            if( level < 0 )
+            {
+                for( std::size_t i = begin; i < end; i++ )
+                    range = ImVec2( ImMin( range.x, s.data[ i ] ), ImMax( range.y, s.data[ i ] ) );
+                return range;
+            }
+            const std::size_t block = Sparkline::BaseBlock << level;
+            const std::size_t first = s.levelStart[ level ];
+            for( std::size_t b = begin / block; b * block < end; b++ )
+            {
+                const ImVec2 v = s.blocks[ first + b ];
+                range = ImVec2( ImMin( range.x, v.x ), ImMax( range.y, v.y ) );
+            }
+            return range;
+        }
+    } // namespace detail
+
+    // Tells the sparklines drawing 'data' that its samples changed.
+    inline void markDataChanged( const void* data )
+    {
+        // Versions come from one counter: an entry dropped and created again never repeats a version seen before.
+        static std::uint64_t lastVersion = 0;
+        detail::DataVersion& entry = detail::dataVersions()[ data ];
+        entry.version = ++lastVersion;
+        entry.lastFrame = GImGui ? ImGui::GetFrameCount() : 0;
+    }
+
+    // Min/max-decimated plot of values[ 0 .. count ). The state (pyramid, zoom) is kept per label in the ID stack.
+    inline void drawSparkline( const char* label, const float* values, std::size_t count )
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if( window->SkipItems )
+            return;
+        const int frame = ImGui::GetFrameCount();
+        detail::evictSparklines( frame );
+        detail::Sparkline& s = detail::sparklines()[ window->GetID( label ) ];
+        s.lastFrame = frame;
+
+        std::uint64_t version = 0;
+        std::unordered_map<const void*, detail::DataVersion>& versions = detail::dataVersions();
+        if( !versions.empty() )
+        {
+            const auto it = versions.find( values );
+            if( it != versions.end() )
+            {
+                version = it->second.version;
+                it->second.lastFrame = frame;
+            }
+        }
+        const ImGuiID probe = detail::probeSamples( values, count );
+        if( s.data != values || s.count != count || s.version != version || s.probe != probe )
+        {
+            if( s.count != count )
+                s.viewBegin = s.viewEnd = 0.0;
+            s.data = values;
+            s.count = count;
+            s.version = version;
+            s.probe = probe;
+            detail::buildSparklinePyramid( s );
+        }
+        if( s.viewEnd <= s.viewBegin )
+        {
+            s.viewBegin = 0.0;
+            s.viewEnd = ( double )count;
+        }
+
+        // One (min, max) pair per pixel column, or the raw samples when zoomed in far enough.
+        const float width = ImMax( ImGui::CalcItemWidth(), 16.0f );
+        const std::size_t viewBegin = ( std::size_t )s.viewBegin;
+        const std::size_t viewEnd = ImMin( ( std::size_t )std::ceil( s.viewEnd ), count );
+        const int columns = ( int )width;
+        const double perColumn = (s.viewEnd - s.viewBegin) / columns;
+        const float* plotValues;
+        int plotCount;
+        if( perColumn < 2.0 )
+        {
+            plotValues = values + viewBegin;
+            plotCount = ( int )(viewEnd - viewBegin);
+        }
+        else
+        {
+            int level = -1;
+            while( level + 1 < ( int )s.levelStart.size() && ( double )(detail::Sparkline::BaseBlock << (level + 1)) <= perColumn )
+                level++;
+            s.plot.resize( ( std::size_t )columns * 2 );
+            for( int c = 0; c < columns; c++ )
+            {
+                const std::size_t begin = ( std::size_t )(s.viewBegin + c * perColumn);
+                const std::size_t end = ImMin( ImMax( ( std::size_t )(s.viewBegin + (c + 1) * perColumn), begin + 1 ), count );
+                const ImVec2 range = detail::sparklineRange( s, begin, end, level );
+                s.plot[ c * 2 ] = range.x;
+                s.plot[ c * 2 + 1 ] = range.y;
+            }
+            plotValues = s.plot.data();
+            plotCount = columns * 2;
+        }
+
+        char overlay[ 64 ];
+        ImFormatString( overlay, IM_ARRAYSIZE( overlay ), "%d - %d of %d", ( int )viewBegin, ( int )viewEnd, ( int )count );
+        ImGui::PlotLines( label, plotValues, plotCount, 0, overlay, FLT_MAX, FLT_MAX, ImVec2( width, sparklineHeight ) );
+
+        // Zoom and pan. The plot takes the mouse wheel while hovered, and the drag while held.
+        const ImRect bb( ImGui::GetItemRectMin(), ImGui::GetItemRectMax() );
+        bool hovered, held;
+        ImGui::ButtonBehavior( bb, ImGui::GetItemID(), &hovered, &held );
+        ImGui::SetItemKeyOwner( ImGuiKey_MouseWheelY );
+        const ImGuiIO& io = ImGui::GetIO();
+        const double span = s.viewEnd - s.viewBegin;
+        if( hovered && io.MouseWheel != 0.0f )
+        {
+            const double pivot = s.viewBegin + span * ImSaturate( (io.MousePos.x - bb.Min.x) / bb.GetWidth() );
+            const double newSpan = ImClamp( span * ImPow( 0.8f, io.MouseWheel ), ImMin( 8.0, ( double )count ), ( double )count );
+            s.viewBegin = pivot - (pivot - s.viewBegin) * newSpan / span;
+            s.viewEnd = s.viewBegin + newSpan;
+        }
+        if( held && io.MouseDelta.x != 0.0f )
+        {
+            const double shift = -io.MouseDelta.x * span / bb.GetWidth();
+            s.viewBegin += shift;
+            s.viewEnd += shift;
+        }
+        if( hovered && ImGui::IsMouseDoubleClicked( ImGuiMouseButton_Left ) )
+            s.viewBegin = s.viewEnd = 0.0;
+        else if( s.viewBegin < 0.0 || s.viewEnd > ( double )count )
+        {
+            const double shift = s.viewBegin < 0.0 ? -s.viewBegin : ( double )count - s.viewEnd;
+            s.viewBegin = ImMax( s.viewBegin + shift, 0.0 );
+            s.viewEnd = ImMin( s.viewEnd + shift, ( double )count );
+        }
+    }
+
+    // ---------- Texture previews ----------
+    // ImTextureID fields are shown as a thumbnail of textureThumbnailSize pixels; clicking it toggles the full-size
+    // view (TEXTURE_VIEW_SIZE). Thumbnails are made by textureThumbnailer (renderer specific, set by the application)
+    // the first time a texture's preview is on screen, at most thumbnailsPerFrame per frame, and remade after
+    // markTextureChanged(). Without a thumbnailer, or until the thumbnail exists, the texture itself is drawn small.
+    struct TextureThumbnailer
+    {
+        // Returns a new texture holding a copy of 'source' downscaled to fit maxSize x maxSize, or 0.
+        ImTextureID ( *create )(ImTextureID source, int maxSize, void* user) = nullptr;
+        void ( *destroy )(ImTextureID thumbnail, void* user) = nullptr;
+        void* user = nullptr;
+    };
+
+    inline TextureThumbnailer textureThumbnailer;
+    inline int textureThumbnailSize = 64;
+    inline int thumbnailsPerFrame = 2;
+
+    namespace detail
+    {
+        struct TextureThumbnail
+        {
+            ImTextureID thumbnail = ImTextureID_Invalid;
+            std::uint64_t version = 0;          // bumped by markTextureChanged()
+            std::uint64_t builtVersion = ~( std::uint64_t )0;
+        };
+
+        inline std::unordered_map<ImTextureID, TextureThumbnail>& textureThumbnails()
+        {
+            static std::unordered_map<ImTextureID, TextureThumbnail> thumbnails;
+            return thumbnails;
+        }
+
+        // Thumbnail of 'texture', made now if it is missing or outdated and the frame's budget allows it.
+        inline ImTextureID thumbnailOf( ImTextureID texture )
+        {
+            if( !textureThumbnailer.create )
+                return texture;
+            TextureThumbnail& entry = textureThumbnails()[ texture ];
+            if( entry.builtVersion != entry.version )
+            {
+                static int frame = -1, made = 0;
+                if( frame != ImGui::GetFrameCount() )
+                {
+                    frame = ImGui::GetFrameCount();
+                    made = 0;
+                }
+                if( made < thumbnailsPerFrame )
+                {
+                    made++;
+                    if( entry.thumbnail != ImTextureID_Invalid && textureThumbnailer.destroy )
+                        textureThumbnailer.destroy( entry.thumbnail, textureThumbnailer.user );
+                    entry.thumbnail = textureThumbnailer.create( texture, textureThumbnailSize, textureThumbnailer.user );
+                    entry.builtVersion = entry.version;
+                }
+            }
+            return entry.thumbnail != ImTextureID_Invalid ? entry.thumbnail : texture;
+        }
+    } // namespace detail
+
+    // The pixels of 'texture' changed: its thumbnail is remade the next time it is shown.
+    inline void markTextureChanged( ImTextureID texture )
+    {
+        std::unordered_map<ImTextureID, detail::TextureThumbnail>& thumbnails = detail::textureThumbnails();
+        const auto it = thumbnails.find( texture );
+        if( it != thumbnails.end() )
+            it->second.version++;
+    }
+
+    // Destroys every thumbnail, e.g. before shutting the renderer down.
+    inline void releaseTextureThumbnails()
+    {
+        for( auto& [texture, entry] : detail::textureThumbnails() )
+            if( entry.thumbnail != ImTextureID_Invalid && textureThumbnailer.destroy )
+                textureThumbnailer.destroy( entry.thumbnail, textureThumbnailer.user );
+        detail::textureThumbnails().clear();
+    }
+
+    // Thumbnail that expands to TEXTURE_VIEW_SIZE when clicked. Nothing is made or drawn while off screen.
+    inline void drawTexturePreview( const char* label, ImTextureID texture )
+    {
+        ImGui::Text( "%s", label );
+        if( !texture )
+        {
+            ImGui::TextDisabled( "Texture not visible or null" );
+            return;
+        }
+        ImGuiStorage* storage = ImGui::GetStateStorage();
+        const ImGuiID id = ImGui::GetID( label );
+        const bool expanded = storage->GetBool( id, false );
+        const ImVec2 size = expanded ? TEXTURE_VIEW_SIZE : ImVec2( ( float )textureThumbnailSize, ( float )textureThumbnailSize );
+
+        const bool visible = ImGui::IsRectVisible( size );
+        if( ImGui::InvisibleButton( label, size ) )
+            storage->SetBool( id, !expanded );
+        if( !visible )
+            return;
+        const ImVec2 min = ImGui::GetItemRectMin();
+        ImGui::GetWindowDrawList()->AddImage( expanded ? texture : detail::thumbnailOf( texture ), min, ImVec2( min.x + size.x, min.y + size.y ) );
+        if( ImGui::IsItemHovered() )
+            ImGui::SetTooltip( expanded ? "Click to shrink" : "Click to expand" );
+    }
+
+    // ---------- Field reveal ----------
+    // revealField( &obj.owner.stats ) asks the next DrawImGui() of the object holding that member to open the headers
+    // around it, scroll it into view and outline it for a moment. See reflective_json_search.h.
+    namespace detail
+    {
+        struct FieldReveal
+        {
+            std::uintptr_t address = 0;         // the member, 0 when nothing is revealed
+            std::size_t size = 0;               // size and kind of the member: a nested object and its first
+            FieldKind kind = FieldKind::Unsupported;    // member share an address
+            bool scroll = false;                // headers are forced open until the member has been scrolled to
+            double highlightUntil = 0.0;
+        };
+        inline FieldReveal fieldReveal;
+
+        // True while a member inside [address, address + size) waits to be scrolled to: its header must be open.
+        inline bool revealInside( const void* address, std::size_t size )
+        {
+            const FieldReveal& reveal = fieldReveal;
+            const std::uintptr_t begin = reinterpret_cast< std::uintptr_t >(address);
+            return reveal.scroll && reveal.address >= begin && reveal.address + reveal.size <= begin + size;
+        }
+
+        // Called right after the item of a member has been submitted.
+        inline void revealItem( const void* address, std::size_t size, FieldKind kind )
+        {
+            FieldReveal& reveal = fieldReveal;
+            if( reveal.address != reinterpret_cast< std::uintptr_t >(address) || reveal.size != size || reveal.kind != kind )
+                return;
+            if( reveal.scroll )
+            {
+                ImGui::ScrollToItem( ImGuiScrollFlags_AlwaysCenterY );
+                reveal.scroll = false;
+            }
+            if( ImGui::GetTime() < reveal.highlightUntil )
+                ImGui::GetWindowDrawList()->AddRect( ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), ImGui::GetColorU32( ImGuiCol_NavCursor ), 0.0f, 0, 2.0f );
+            else
+                reveal.address = 0;
+        }
+    } // namespace detail
+
+    // 'member' is the address of a field described by 'field' (its FieldMeta, at any nesting depth).
+    inline void revealField( const void* member, const FieldMeta& field, float highlightSeconds = 2.0f )
+    {
+        detail::fieldReveal = detail::FieldReveal{ reinterpret_cast< std::uintptr_t >(member), field.size, field.kind, true, ImGui::GetTime() + highlightSeconds };
+    }
+
+    // ---------- Per-field value/widget ----------
+    template<typename M>
+    std::string fieldToString( const M& value )
+    {
+        if constexpr( std::is_same_v<M, bool> )
+            return value ? "true" : "false";
+        else if constexpr( std::is_same_v<M, std::string> )
+            return "\"" + value + "\"";
+        else if constexpr( std::is_arithmetic_v<M> )
+            return std::to_string( value );
+        else if constexpr( is_std_vector_v<M> || std::is_array_v<M> )
+            return "[" + std::to_string( std::size( value ) ) + " items]";
+        else
+            return "{object}";
+    }
+
+    template<typename E>
+    int drawVector( const char* label, std::vector<E>& values, E* before = nullptr );
+
+    // Draws the widget for one non-reflected value. Returns true when the user edited it.
+    template<typename M>
+    bool drawValue( const char* label, M& value, bool hasRange = false, double rangeMin = 0.0, double rangeMax = 0.0 )
+    {
+        bool changed = false;
+        if constexpr( std::is_same_v<M, int> )
+        {
+            if( hasRange )
+                changed = ImGui::SliderInt( label, &value, ( int )rangeMin, ( int )rangeMax );
+            else
+                changed = ImGui::DragInt( label, &value );
+        }
+        else if constexpr( std::is_same_v<M, float> )
+        {
+            if( hasRange )
+                changed = ImGui::SliderFloat( label, &value, ( float )rangeMin, ( float )rangeMax );
+            else
+                changed = ImGui::DragFloat( label, &value, 0.1f );
+        }
+        else if( hasRange )
+        {
+            ImGui::Text( "Unsupported ranged type" );
+        }
+        else if constexpr( std::is_same_v<M, bool> )
+        {
+            changed = ImGui::Checkbox( label, &value );
+        }
+        else if constexpr( std::is_same_v<M, ImVec2> )
+        {
+            changed = ImGui::DragFloat2( label, ( float* )&value );
+        }
+        else if constexpr( std::is_same_v<M, ImVec4> )
+        {
+            changed = ImGui::ColorEdit4( label, ( float* )&value,
+                ImGuiColorEditFlags_DisplayRGB |
+                ImGuiColorEditFlags_PickerHueBar |
+                ImGuiColorEditFlags_AlphaBar );
+        }
+        else if constexpr( std::is_same_v<M, ImTextureID> )
+        {
+            drawTexturePreview( label, value );
+        }
+        else if constexpr( std::is_same_v<M, std::string> )
+        {
+            // Edits the string's own storage, growing it through the resize callback: no copy, no length limit
+            changed = ImGui::InputText( label, &value );
+        }
+        else if constexpr( is_std_vector_v<M> )
+        {
+            changed = drawVector( label, value ) >= 0;
+        }
+        else if constexpr( std::is_same_v<std::remove_extent_t<M>, float> && std::rank_v<M> == 1 )
+        {
+            drawSparkline( label, value, std::extent_v<M> );
+        }
+        else if constexpr( has_getFields_v<M> )
+        {
+            ImGui::TextDisabled( "{...}" );
+        }
+        return changed;
+    }
+
+    // Draws the widget for one field. Returns true when the user edited the value.
+    template<typename C, typename M>
+    bool drawField( const FieldDesc<C, M>& desc, C& self )
+    {
+        ImGui::PushID( desc.name );
+        M& value = self.*desc.member;
+        bool changed = false;
+        if constexpr( has_getFields_v<M> )
+        {
+            if( detail::revealInside( &value, sizeof( M ) ) )
+                ImGui::SetNextItemOpen( true );
+            const bool open = ImGui::CollapsingHeader( desc.name, nestedHeaderFlags );
+            detail::revealItem( &value, sizeof( M ), FieldKind::Object );
+            if( open )
+            {
+                detail::ChangeRecorder& rec = detail::changeRecorder;
+                if( rec.list )
+                {
+                    IM_ASSERT( rec.depth < IM_ARRAYSIZE( rec.path ) );
+                    rec.path[ rec.depth++ ] = desc.name;
+                }
+                changed = DrawImGui( value, true ) != 0;
+                if( rec.list )
+                    rec.depth--;
+            }
+        }
+        else if constexpr( is_std_vector_v<M> )
+        {
+            using E = typename M::value_type;
+            E before{};
+            const bool captureBefore = std::is_trivially_copyable_v<E> && detail::observingEdits();
+            const int edited = drawVector( desc.name, value, captureBefore ? &before : nullptr );
+            if( edited >= 0 )
+            {
+                detail::recordChange<C>( desc.name, &value, ( std::size_t )edited, captureBefore ? &before : nullptr, &value[ edited ] );
+                changed = true;
+            }
+        }
+        else if constexpr( std::is_array_v<M> )
+        {
+            drawValue( desc.name, value );      // read-only
+        }
+        else
+        {
+            // Previous value for EditObserver: copied for small trivial leaves, only while being typed into for strings.
+            M before{};
+            bool captureBefore = false;
+            if( detail::observingEdits() )
+            {
+                if constexpr( std::is_trivially_copyable_v<M> )
+                    captureBefore = true;
+                else if constexpr( std::is_same_v<M, std::string> )
+                    captureBefore = ImGui::GetActiveID() == ImGui::GetID( desc.name );
+                if( captureBefore )
+                    before = value;
+            }
+            changed = drawValue( desc.name, value, desc.hasRange, desc.rangeMin, desc.rangeMax );
+            if( changed )
+                detail::recordChange<C>( desc.name, &value, FieldChange::npos, captureBefore ? &before : nullptr );
+        }
+        if constexpr( !has_getFields_v<M> )
+            detail::revealItem( &value, sizeof( M ), fieldKindOf<M>() );
+        ImGui::PopID();
+        return changed;
+    }
+
+    // Table cell widget: single line and full column width, so rows keep the fixed height the clipper relies on.
+    template<typename M>
+    bool drawCell( M& value, bool hasRange = false, double rangeMin = 0.0, double rangeMax = 0.0 )
+    {
+        ImGui::TableNextColumn();
+        if constexpr( std::is_same_v<M, ImTextureID> )
+        {
+            const float size = ImGui::GetFrameHeight();
+            if( value )
+                ImGui::Image( detail::thumbnailOf( value ), ImVec2( size, size ) );
+            else
+                ImGui::TextDisabled( "null" );
+            return false;
+        }
+        else if constexpr( is_std_vector_v<M> || std::is_array_v<M> )
+        {
+            ImGui::TextDisabled( "[%d]", ( int )std::size( value ) );
+            return false;
+        }
+        else
+        {
+            ImGui::SetNextItemWidth( -FLT_MIN );
+            return drawValue( "##v", value, hasRange, rangeMin, rangeMax );
+        }
+    }
+
+    // One table row worth of cells: one per field of a reflected E, a single one otherwise.
+    template<typename E>
+    bool drawTableCells( E& element )
+    {
+        bool changed = false;
+        if constexpr( has_getFields_v<E> )
+        {
+            forEachField<E>( [&]( const auto& desc )
+            {
+                ImGui::PushID( desc.name );
+                changed |= drawCell( element.*desc.member, desc.hasRange, desc.rangeMin, desc.rangeMax );
+                ImGui::PopID();
+            } );
+        }
+        else
+        {
+            changed = drawCell( element );
+        }
+        return changed;
+    }
+
+    // std::vector<E> field: a tree node with a scrolling table of at most vectorVisibleRows rows. Only the visible
+    // rows are submitted (ImGuiListClipper), so the cost does not depend on the element count. Reflected elements get
+    // one column per field. Returns the index of the edited element, or -1. When 'before' is given, the element's
+    // value from before the edit is copied to it. Large std::vector<float> get a sparkline above the table.
+    template<typename E>
+    int drawVector( const char* label, std::vector<E>& values, E* before )
+    {
+        const int count = ( int )values.size();
+        if( !ImGui::TreeNodeEx( label, ImGuiTreeNodeFlags_None, "%s [%d]", label, count ) )
+            return -1;
+
+        if constexpr( std::is_same_v<E, float> )
+            if( count >= sparklineMinCount )
+                drawSparkline( "##sparkline", values.data(), values.size() );
+
+        int edited = -1;
+        int columns = 2;
+        if constexpr( has_getFields_v<E> )
+            columns = 1 + ( int )fieldCount<E>();
+
+        const float rowHeight = ImGui::GetFrameHeightWithSpacing();
+        const int visibleRows = ImClamp( count, 1, vectorVisibleRows );
+        const ImVec2 outerSize( 0.0f, rowHeight * (visibleRows + (has_getFields_v<E> ? 1 : 0)) + ImGui::GetStyle().CellPadding.y * 2.0f );
+        const ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_Resizable;
+        if( count > 0 && ImGui::BeginTable( "##elements", columns, flags, outerSize ) )
+        {
+            ImGui::TableSetupScrollFreeze( 0, 1 );
+            ImGui::TableSetupColumn( "#", ImGuiTableColumnFlags_WidthFixed );
+            if constexpr( has_getFields_v<E> )
+            {
+                forEachField<E>( [&]( const auto& desc ) { ImGui::TableSetupColumn( desc.name ); } );
+                ImGui::TableHeadersRow();
+            }
+            else
+            {
+                ImGui::TableSetupColumn( "value" );
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin( count, rowHeight );
+            while( clipper.Step() )
+            {
+                for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ )
+                {
+                    ImGui::PushID( i );
+                    ImGui::TableNextRow( ImGuiTableRowFlags_None, rowHeight );
+                    ImGui::TableNextColumn();
+                    ImGui::AlignTextToFramePadding();
+                    ImGui::Text( "%d", i );
+
+                    if constexpr( std::is_trivially_copyable_v<E> )
+                    {
+                        const E previous = values[ i ];
+                        if( drawTableCells( values[ i ] ) )
+                        {
+                            edited = i;
+                            if( before )
+                                *before = previous;
+                        }
+                    }
+                    else if( drawTableCells( values[ i ] ) )
+                    {
+                        edited = i;
+                    }
+                    ImGui::PopID();
+                }
+            }
+            ImGui::EndTable();
+        }
+        if constexpr( std::is_same_v<E, float> )
+            if( edited >= 0 && count >= sparklineMinCount )
+                markDataChanged( values.data() );
+        ImGui::TreePop();
+        return edited;
+    }
+
+    // ---------- Runtime table builder (used by RTTI_FIELDS_END) ----------
+    template<typename T, typename M>
+    FieldInfo<T> makeFieldInfo( const FieldDesc<T, M>& desc )
+    {
+        FieldInfo<T> info;
+        info.name = desc.name;
+        info.typeName = getTypeName<M>();
+        info.kind = fieldKindOf<M>();
+        info.offset = memberOffset( desc.member );
+        info.size = sizeof( M );
+        if constexpr( has_getFields_v<M> )
+            info.nested = &getTypeMeta<M>();
+        if constexpr( is_std_vector_v<M> )
+            info.element = &getVectorMeta<typename M::value_type>();
+        if constexpr( std::rank_v<M> == 1 )
+        {
+            constexpr FieldKind elementKind = fieldKindOf<std::remove_extent_t<M>>();
+            if constexpr( elementKind == FieldKind::Bool || elementKind == FieldKind::Int || elementKind == FieldKind::Float )
+            {
+                info.arrayElement = elementKind;
+                info.arrayCount = std::extent_v<M>;
+            }
+        }
+        if( desc.hasRange )
+        {
+            if constexpr( std::is_same_v<M, int> )
+                info.intRange = std::make_pair( ( int )desc.rangeMin, ( int )desc.rangeMax );
+            else if constexpr( std::is_same_v<M, float> )
+                info.floatRange = std::make_pair( ( float )desc.rangeMin, ( float )desc.rangeMax );
+        }
+        info.getter = [desc]( const T& self ) { return fieldToString( self.*desc.member ); };
+        info.drawGui = [desc]( T& self ) { return drawField( desc, self ); };
+        return info;
+    }
+
+    template<typename T>
+    std::vector<FieldInfo<T>> makeFieldTable()
+    {
+        std::vector<FieldInfo<T>> fields;
+        fields.reserve( fieldCount<T>() );
+        forEachField<T>( [&]( const auto& desc ) { fields.push_back( makeFieldInfo( desc ) ); } );
+        return fields;
+    }
+
+    template<typename T>
+    const TypeMeta& getTypeMeta()
+    {
+        static const TypeMeta meta = []()
+        {
+            TypeMeta result;
+            result.name = getTypeName<T>();
+            result.size = sizeof( T );
+            for( const FieldInfo<T>& field : T::getFields() )
+                result.fields.push_back( &field );
+            result.schemaHash = computeSchemaHash( result );
+            return result;
+        }();
+        return meta;
+    }
+
+    // ---------- ImGui drawer ----------
+    // Header ID = hash(type id) seeded with the ID of the object pointer in the current ID stack: no string formatting,
+    // no allocation. Equivalent to CollapsingHeader("TypeName##<address>") but submitted straight to TreeNodeBehavior().
+    template<typename T>
+    bool BeginObjectHeader( T& obj, bool skipHeader )
+    {
+        if( skipHeader )
+            return true;
+
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if( window->SkipItems )
+            return false;
+
+        const TypeInfo& type = getTypeInfo<T>();
+        const ImGuiID id = ImHashData( &type.id, sizeof( type.id ), window->GetID( &obj ) );
+        if( detail::revealInside( &obj, sizeof( T ) ) )
+            ImGui::SetNextItemOpen( true );
+        return ImGui::TreeNodeBehavior( id, ImGuiTreeNodeFlags_CollapsingHeader | ImGuiTreeNodeFlags_DefaultOpen,
+            type.name.data(), type.name.data() + type.name.size() );
+    }
+
+    template<typename T>
+    FieldMask DrawImGui( T& obj, bool skipHeader )
+    {
+        static_assert( fieldCount<T>() <= 64, "FieldMask holds up to 64 fields" );
+        FieldMask changed = 0;
+        if( BeginObjectHeader( obj, skipHeader ) )
+        {
+            ImGui::PushID( &obj );
+            ImGui::Indent();
+            forEachFieldIndexed<T>( [&]( const auto& desc, std::size_t index )
+            {
+                if( drawField( desc, obj ) )
+                    changed |= FieldMask( 1 ) << index;
+            } );
+            ImGui::Unindent();
+            ImGui::PopID();
+        }
+        return changed;
+    }
+
+    // Same as DrawImGui(), and also appends the path of every edited leaf field to 'changes'.
+    template<typename T>
+    FieldMask DrawImGui( T& obj, ChangeList& changes, bool skipHeader = false )
+    {
+        detail::ChangeRecorder& rec = detail::changeRecorder;
+        IM_ASSERT( rec.list == nullptr && "Recording DrawImGui() calls can't be nested" );
+        rec.list = &changes;
+        rec.root = &obj;
+        rec.depth = 0;
+        const FieldMask changed = DrawImGui( obj, skipHeader );
+        rec.list = nullptr;
+        return changed;
+    }
+
+    // Same output as DrawImGui(), but goes through the type-erased getFields() table (one std::function call per field).
+    template<typename T>
+    FieldMask DrawImGuiTable( T& obj, bool skipHeader = false )
+    {
+        FieldMask changed = 0;
+        if( BeginObjectHeader( obj, skipHeader ) )
+        {
+            ImGui::PushID( &obj );
+            ImGui::Indent();
+            const auto& fields = T::getFields();
+            for( std::size_t i = 0; i < fields.size(); i++ )
+            {
+                if( fields[ i ].drawGui && fields[ i ].drawGui( obj ) )
+                    changed |= FieldMask( 1 ) << i;
+            }
+            ImGui::Unindent();
+            ImGui::PopID();
+        }
+        return changed;
+    }
+
+    // ---------- JSON Serializer ----------
+    template<typename T>
+    json toJson( const T& obj )
+    {
+        json j;
+        j[ "type" ] = getTypeName<T>();
+        forEachField<T>( [&]( const auto& desc )
+        {
+            using M = typename std::decay_t<decltype(desc)>::Member;
+            j[ desc.name ][ "type" ] = getTypeName<M>();
+            j[ desc.name ][ "value" ] = fieldToString( obj.*desc.member );
+        } );
+        return j;
+    }
+} // namespace ReflectiveJson
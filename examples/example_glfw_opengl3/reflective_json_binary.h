@@ -0,0 +1,237 @@
+// ReflectiveJson binary mode: CBOR / MessagePack encoding of reflected structs.
+//
+// BinaryWriter mirrors JsonWriter: it walks fieldDescs() and encodes member values straight to an nlohmann output
+// adapter, no DOM involved. The document has the same shape as the dumpJson() one (a map of field name -> value,
+// nested maps for reflected members, arrays for ImVec2/ImVec4, std::vector and C arrays); floats are stored as 32-bit
+// floats.
+// fromBinary() decodes it with nlohmann's binary_reader feeding the same JsonReader used by fromJson(),
+// so the loading rules (unknown keys skipped, ranges clamped, ...) are identical.
+//
+// Usage:
+//   std::vector<std::uint8_t> bytes;
+//   ReflectiveJson::dumpBinary( material, bytes, ReflectiveJson::BinaryFormat::MsgPack );
+//   ReflectiveJson::fromBinary( material, bytes, ReflectiveJson::BinaryFormat::MsgPack );
+
+#pragma once
+
+#include "reflective_json_stream.h"
+#include <cstring>
+
+namespace ReflectiveJson
+{
+    enum class BinaryFormat
+    {
+        Cbor,       // RFC 8949
+        MsgPack,    // https://msgpack.org
+    };
+
+    using BinaryOutput = nlohmann::detail::output_adapter_t<std::uint8_t>;
+
+    class BinaryWriter
+    {
+    public:
+        BinaryWriter( BinaryOutput out, BinaryFormat format )
+            : m_out( std::move( out ) ), m_format( format ) {}
+
+        template<typename T>
+        void writeObject( const T& obj )
+        {
+            writeMapHeader( fieldCount<T>() );
+            forEachField<T>( [&]( const auto& desc )
+            {
+                writeString( desc.name );
+                writeValue( obj.*desc.member );
+            } );
+        }
+
+        template<typename M>
+        void writeValue( const M& value )
+        {
+            if constexpr( has_getFields_v<M> )
+                writeObject( value );
+            else if constexpr( std::is_same_v<M, bool> )
+                writeBool( value );
+            else if constexpr( std::is_integral_v<M> && std::is_signed_v<M> )
+                writeInteger( ( std::int64_t )value );
+            else if constexpr( std::is_integral_v<M> )
+                writeUnsigned( ( std::uint64_t )value );
+            else if constexpr( std::is_same_v<M, float> )
+                writeFloat( value );
+            else if constexpr( std::is_floating_point_v<M> )
+                writeDouble( ( double )value );
+            else if constexpr( std::is_same_v<M, std::string> )
+                writeString( value );
+            else if constexpr( std::is_same_v<M, ImVec2> )
+                writeFloatArray( &value.x, 2 );
+            else if constexpr( std::is_same_v<M, ImVec4> )
+                writeFloatArray( &value.x, 4 );
+            else if constexpr( is_std_vector_v<M> )
+            {
+                writeArrayHeader( value.size() );
+                for( const auto& element : value )
+                    writeValue( element );
+            }
+            else if constexpr( std::rank_v<M> == 1 && std::is_arithmetic_v<std::remove_extent_t<M>> )
+            {
+                writeArrayHeader( std::extent_v<M> );
+                for( std::size_t i = 0; i < std::extent_v<M>; i++ )
+                    writeValue( value[ i ] );
+            }
+            else if constexpr( std::is_pointer_v<M> )
+                writeUnsigned( ( std::uint64_t )reinterpret_cast< uintptr_t >(value) );
+            else
+                writeNull();
+        }
+
+        void writeNull()
+        {
+            m_out->write_character( m_format == BinaryFormat::Cbor ? 0xF6 : 0xC0 );
+        }
+
+        void writeBool( bool value )
+        {
+            if( m_format == BinaryFormat::Cbor )
+                m_out->write_character( value ? 0xF5 : 0xF4 );
+            else
+                m_out->write_character( value ? 0xC3 : 0xC2 );
+        }
+
+        void writeUnsigned( std::uint64_t value )
+        {
+            if( m_format == BinaryFormat::Cbor )
+            {
+                writeCborHeader( 0, value );
+                return;
+            }
+            if( value < 0x80 )              m_out->write_character( ( std::uint8_t )value );
+            else if( value <= 0xFF )        writeBigEndian( 0xCC, value, 1 );
+            else if( value <= 0xFFFF )      writeBigEndian( 0xCD, value, 2 );
+            else if( value <= 0xFFFFFFFF )  writeBigEndian( 0xCE, value, 4 );
+            else                            writeBigEndian( 0xCF, value, 8 );
+        }
+
+        void writeInteger( std::int64_t value )
+        {
+            if( value >= 0 )
+            {
+                writeUnsigned( ( std::uint64_t )value );
+                return;
+            }
+            if( m_format == BinaryFormat::Cbor )
+            {
+                writeCborHeader( 1, ( std::uint64_t )(-1 - value) );
+                return;
+            }
+            if( value >= -32 )              m_out->write_character( ( std::uint8_t )( std::int8_t )value );
+            else if( value >= INT8_MIN )    writeBigEndian( 0xD0, ( std::uint64_t )value, 1 );
+            else if( value >= INT16_MIN )   writeBigEndian( 0xD1, ( std::uint64_t )value, 2 );
+            else if( value >= INT32_MIN )   writeBigEndian( 0xD2, ( std::uint64_t )value, 4 );
+            else                            writeBigEndian( 0xD3, ( std::uint64_t )value, 8 );
+        }
+
+        void writeFloat( float value )
+        {
+            std::uint32_t bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            writeBigEndian( m_format == BinaryFormat::Cbor ? 0xFA : 0xCA, bits, 4 );
+        }
+
+        void writeDouble( double value )
+        {
+            std::uint64_t bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            writeBigEndian( m_format == BinaryFormat::Cbor ? 0xFB : 0xCB, bits, 8 );
+        }
+
+        void writeString( std::string_view str )
+        {
+            const std::uint64_t length = str.size();
+            if( m_format == BinaryFormat::Cbor )
+                writeCborHeader( 3, length );
+            else if( length < 32 )          m_out->write_character( ( std::uint8_t )(0xA0 | length) );
+            else if( length <= 0xFF )       writeBigEndian( 0xD9, length, 1 );
+            else if( length <= 0xFFFF )     writeBigEndian( 0xDA, length, 2 );
+            else                            writeBigEndian( 0xDB, length, 4 );
+            m_out->write_characters( reinterpret_cast< const std::uint8_t* >(str.data()), str.size() );
+        }
+
+        void writeArrayHeader( std::size_t count )
+        {
+            if( m_format == BinaryFormat::Cbor )
+                writeCborHeader( 4, count );
+            else if( count < 16 )           m_out->write_character( ( std::uint8_t )(0x90 | count) );
+            else if( count <= 0xFFFF )      writeBigEndian( 0xDC, count, 2 );
+            else                            writeBigEndian( 0xDD, count, 4 );
+        }
+
+        void writeMapHeader( std::size_t count )
+        {
+            if( m_format == BinaryFormat::Cbor )
+                writeCborHeader( 5, count );
+            else if( count < 16 )           m_out->write_character( ( std::uint8_t )(0x80 | count) );
+            else if( count <= 0xFFFF )      writeBigEndian( 0xDE, count, 2 );
+            else                            writeBigEndian( 0xDF, count, 4 );
+        }
+
+    private:
+        void writeFloatArray( const float* values, int count )
+        {
+            writeArrayHeader( ( std::size_t )count );
+            for( int i = 0; i < count; i++ )
+                writeFloat( values[ i ] );
+        }
+
+        // CBOR initial byte: major type in the top 3 bits, then the argument inline (< 24) or in 1/2/4/8 trailing bytes.
+        void writeCborHeader( std::uint8_t major, std::uint64_t value )
+        {
+            const std::uint8_t lead = ( std::uint8_t )(major << 5);
+            if( value < 24 )                m_out->write_character( ( std::uint8_t )(lead | value) );
+            else if( value <= 0xFF )        writeBigEndian( lead | 24, value, 1 );
+            else if( value <= 0xFFFF )      writeBigEndian( lead | 25, value, 2 );
+            else if( value <= 0xFFFFFFFF )  writeBigEndian( lead | 26, value, 4 );
+            else                            writeBigEndian( lead | 27, value, 8 );
+        }
+
+        void writeBigEndian( int lead, std::uint64_t value, int bytes )
+        {
+            std::uint8_t buffer[ 9 ];
+            buffer[ 0 ] = ( std::uint8_t )lead;
+            for( int i = 0; i < bytes; i++ )
+                buffer[ 1 + i ] = ( std::uint8_t )(value >> (8 * (bytes - 1 - i)));
+            m_out->write_characters( buffer, ( std::size_t )bytes + 1 );
+        }
+
+        BinaryOutput m_out;
+        BinaryFormat m_format;
+    };
+
+    inline json::input_format_t toInputFormat( BinaryFormat format )
+    {
+        return format == BinaryFormat::Cbor ? json::input_format_t::cbor : json::input_format_t::msgpack;
+    }
+
+    // Appends the encoding of obj to 'out'.
+    template<typename T>
+    void dumpBinary( const T& obj, std::vector<std::uint8_t>& out, BinaryFormat format = BinaryFormat::Cbor )
+    {
+        BinaryWriter writer( nlohmann::detail::output_adapter<std::uint8_t>( out ), format );
+        writer.writeObject( obj );
+    }
+
+    // Loads obj from one encoded document in [data, data + size).
+    template<typename T>
+    bool fromBinary( T& obj, const std::uint8_t* data, std::size_t size, BinaryFormat format = BinaryFormat::Cbor, std::string* error = nullptr )
+    {
+        JsonReader reader( &obj, getTypeMeta<T>() );
+        const bool ok = json::sax_parse( data, data + size, &reader, toInputFormat( format ) );
+        if( !ok && error )
+            *error = reader.error();
+        return ok;
+    }
+
+    template<typename T>
+    bool fromBinary( T& obj, const std::vector<std::uint8_t>& data, BinaryFormat format = BinaryFormat::Cbor, std::string* error = nullptr )
+    {
+        return fromBinary( obj, data.data(), data.size(), format, error );
+    }
+} // namespace ReflectiveJson
@@ -0,0 +1,348 @@
+// ReflectiveJson hot-reload: keeps reflected objects in sync with the JSON files that back them.
+//
+// A background thread waits for file changes (inotify on Linux, modification-time polling elsewhere) and re-parses
+// only the files that changed. Each file is parsed on top of the state it had at the previous load, and compared
+// with it field by field: only the leaves that differ are queued for the UI thread, so fields that were not touched
+// in the file keep whatever the UI did to them. applyPending(), called at the start of a frame, copies those leaves
+// into the live objects; it costs nothing when no file changed.
+//
+// Usage:
+//   static ReflectiveJson::HotReloader reloader;
+//   reloader.watch( "material.json", material );      // loads the file now if it exists
+//   reloader.start();
+//   // each frame, before drawing:
+//   reloader.applyPending();
+//
+// Objects must outlive the reloader. watch() must be called before start().
+
+#pragma once
+
+#include "reflective_json_stream.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ReflectiveJson
+{
+    namespace detail
+    {
+        inline bool valuesEqual( FieldKind kind, const TypeMeta* nested, const VectorMeta* element, const void* a, const void* b )
+        {
+            switch( kind )
+            {
+            case FieldKind::String:
+                return *static_cast< const std::string* >(a) == *static_cast< const std::string* >(b);
+            case FieldKind::Object:
+                if( nested )
+                    for( const FieldMeta* field : nested->fields )
+                        if( !valuesEqual( field->kind, field->nested, field->element, field->ptr( a ), field->ptr( b ) ) )
+                            return false;
+                return true;
+            case FieldKind::Vector:
+            {
+                const std::size_t count = element->size( a );
+                if( count != element->size( b ) )
+                    return false;
+                for( std::size_t i = 0; i < count; i++ )
+                    if( !valuesEqual( element->elementKind, element->elementNested, nullptr, element->at_const( a, i ), element->at_const( b, i ) ) )
+                        return false;
+                return true;
+            }
+            default:
+                return std::memcmp( a, b, leafSize( kind ) ) == 0;
+            }
+        }
+
+        // Appends a FieldChange for every leaf that differs between objects a and b of the given type. A std::vector
+        // that changed size is reported as a whole (elementIndex == npos), otherwise per differing element.
+        inline void diffObjects( const TypeMeta& type, const void* a, const void* b, std::size_t baseOffset,
+            const json::json_pointer& path, std::vector<FieldChange>& out )
+        {
+            for( const FieldMeta* field : type.fields )
+            {
+                const void* fa = field->ptr( a );
+                const void* fb = field->ptr( b );
+                const std::size_t offset = baseOffset + field->offset;
+                if( field->kind == FieldKind::Object && field->nested )
+                {
+                    diffObjects( *field->nested, fa, fb, offset, path / field->name, out );
+                }
+                else if( field->kind == FieldKind::Vector && field->element )
+                {
+                    const VectorMeta& element = *field->element;
+                    const std::size_t count = element.size( fa );
+                    if( count != element.size( fb ) )
+                    {
+                        out.push_back( FieldChange{ path / field->name, offset, field, FieldChange::npos } );
+                        continue;
+                    }
+                    for( std::size_t i = 0; i < count; i++ )
+                        if( !valuesEqual( element.elementKind, element.elementNested, nullptr, element.at_const( fa, i ), element.at_const( fb, i ) ) )
+                            out.push_back( FieldChange{ path / field->name / i, offset, field, i } );
+                }
+                else if( field->kind != FieldKind::Unsupported && !valuesEqual( field->kind, field->nested, field->element, fa, fb ) )
+                {
+                    out.push_back( FieldChange{ path / field->name, offset, field, FieldChange::npos } );
+                }
+            }
+        }
+
+        // Copies the leaf named by 'change' from src to dst (two objects of the same type).
+        inline void copyChange( void* dst, const void* src, const FieldChange& change )
+        {
+            char* dstMember = static_cast< char* >(dst) + change.offset;
+            const char* srcMember = static_cast< const char* >(src) + change.offset;
+            const FieldMeta& field = *change.field;
+            if( field.kind == FieldKind::Vector )
+            {
+                if( change.elementIndex == FieldChange::npos )
+                    field.element->assign( dstMember, srcMember );
+                else if( change.elementIndex < field.element->size( dstMember ) )
+                    field.element->copyElement( dstMember, srcMember, change.elementIndex );
+            }
+            else if( field.kind == FieldKind::String )
+            {
+                *reinterpret_cast< std::string* >(dstMember) = *reinterpret_cast< const std::string* >(srcMember);
+            }
+            else
+            {
+                std::memcpy( dstMember, srcMember, leafSize( field.kind ) );
+            }
+        }
+
+        inline bool readFile( const std::filesystem::path& path, std::string& text )
+        {
+            std::ifstream file( path, std::ios::binary );
+            if( !file )
+                return false;
+            std::ostringstream stream;
+            stream << file.rdbuf();
+            text = std::move( stream ).str();
+            return true;
+        }
+    } // namespace detail
+
+    class HotReloader
+    {
+    public:
+        HotReloader() = default;
+        HotReloader( const HotReloader& ) = delete;
+        HotReloader& operator=( const HotReloader& ) = delete;
+
+        ~HotReloader()
+        {
+            stop();
+        }
+
+        // Binds 'target' to the JSON file at 'path' and loads it now if it exists.
+        template<typename T>
+        bool watch( const std::filesystem::path& path, T& target, std::string* error = nullptr )
+        {
+            IM_ASSERT( !m_thread.joinable() && "watch() must be called before start()" );
+            std::unique_ptr<Watch<T>> watch = std::make_unique<Watch<T>>( std::filesystem::absolute( path ), target );
+            std::string text;
+            bool ok = true;
+            if( detail::readFile( watch->path, text ) )
+                ok = fromJson( target, text, error );
+            watch->shadow = target;
+            watch->lastWrite = lastWriteTime( watch->path );
+            m_watches.push_back( std::move( watch ) );
+            return ok;
+        }
+
+        void start()
+        {
+            if( m_thread.joinable() || m_watches.empty() )
+                return;
+            m_running = true;
+            m_thread = std::thread( [this]() { run(); } );
+        }
+
+        void stop()
+        {
+            m_running = false;
+            if( m_thread.joinable() )
+                m_thread.join();
+        }
+
+        // Applies the field changes of the files reloaded since the last call. Returns the number of leaves written.
+        int applyPending()
+        {
+            if( !m_hasPending.load( std::memory_order_acquire ) )
+                return 0;
+            std::vector<Update> updates;
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                updates.swap( m_pending );
+                m_hasPending.store( false, std::memory_order_relaxed );
+            }
+            int count = 0;
+            for( const Update& update : updates )
+            {
+                for( const FieldChange& change : update.changes )
+                    detail::copyChange( update.watch->target, update.state.get(), change );
+                count += ( int )update.changes.size();
+            }
+            return count;
+        }
+
+        // Message of the last failed reload (e.g. a syntax error in a file being edited), empty once a reload succeeds.
+        std::string lastError() const
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            return m_error;
+        }
+
+    private:
+        struct WatchBase
+        {
+            std::filesystem::path path;
+            void* target;
+            const TypeMeta* type;
+            std::filesystem::file_time_type lastWrite;
+            int directoryWatch = -1;                    // inotify watch descriptor of the file's directory
+
+            WatchBase( std::filesystem::path p, void* t, const TypeMeta* m ) : path( std::move( p ) ), target( t ), type( m ) {}
+            virtual ~WatchBase() = default;
+
+            // Re-parses the file on top of the last loaded state. Returns a copy of the new state (an object of the
+            // target's type) and fills 'changes' with the leaves that differ, or returns null on a parse error.
+            virtual std::shared_ptr<void> reload( const std::string& text, std::vector<FieldChange>& changes, std::string& error ) = 0;
+        };
+
+        template<typename T>
+        struct Watch : WatchBase
+        {
+            T shadow;       // object as of the last load, owned by the watcher thread after start()
+
+            Watch( std::filesystem::path p, T& t ) : WatchBase( std::move( p ), &t, &getTypeMeta<T>() ) {}
+
+            std::shared_ptr<void> reload( const std::string& text, std::vector<FieldChange>& changes, std::string& error ) override
+            {
+                std::shared_ptr<T> next = std::make_shared<T>( shadow );
+                if( !fromJson( *next, text, &error ) )
+                    return nullptr;
+                detail::diffObjects( *type, &shadow, next.get(), 0, json::json_pointer(), changes );
+                shadow = *next;
+                return next;
+            }
+        };
+
+        struct Update
+        {
+            WatchBase* watch;
+            std::shared_ptr<void> state;
+            std::vector<FieldChange> changes;
+        };
+
+        static std::filesystem::file_time_type lastWriteTime( const std::filesystem::path& path )
+        {
+            std::error_code ec;
+            const std::filesystem::file_time_type time = std::filesystem::last_write_time( path, ec );
+            return ec ? std::filesystem::file_time_type::min() : time;
+        }
+
+        void reload( WatchBase& watch )
+        {
+            std::string text;
+            if( !detail::readFile( watch.path, text ) )
+                return;
+            Update update{ &watch, nullptr, {} };
+            std::string error;
+            update.state = watch.reload( text, update.changes, error );
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_error = error;
+            if( update.state && !update.changes.empty() )
+            {
+                m_pending.push_back( std::move( update ) );
+                m_hasPending.store( true, std::memory_order_release );
+            }
+        }
+
+#ifdef __linux__
+        // Watches the directories (editors often save by writing a temporary file and renaming it over the original).
+        void run()
+        {
+            const int fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+            if( fd < 0 )
+                return pollLoop();
+            // Files in the same directory share its watch descriptor; events match on (descriptor, name), so a
+            // file with the same name in another watched directory does not trigger a reload.
+            for( const std::unique_ptr<WatchBase>& watch : m_watches )
+                watch->directoryWatch = inotify_add_watch( fd, watch->path.parent_path().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+
+            alignas(inotify_event) char buffer[ 4096 ];
+            std::vector<WatchBase*> changed;
+            while( m_running.load( std::memory_order_relaxed ) )
+            {
+                pollfd pfd{ fd, POLLIN, 0 };
+                if( poll( &pfd, 1, 100 ) <= 0 )
+                    continue;
+
+                // Drain everything that is queued, then reload each changed file once.
+                changed.clear();
+                ssize_t length;
+                while( (length = read( fd, buffer, sizeof( buffer ) )) > 0 )
+                {
+                    for( char* p = buffer; p < buffer + length; )
+                    {
+                        const inotify_event* event = reinterpret_cast< const inotify_event* >(p);
+                        p += sizeof( inotify_event ) + event->len;
+                        if( event->len == 0 )
+                            continue;
+                        for( const std::unique_ptr<WatchBase>& watch : m_watches )
+                            if( watch->directoryWatch == event->wd && watch->path.filename() == event->name && std::find( changed.begin(), changed.end(), watch.get() ) == changed.end() )
+                                changed.push_back( watch.get() );
+                    }
+                }
+                for( WatchBase* watch : changed )
+                    reload( *watch );
+            }
+            close( fd );
+        }
+#else
+        void run()
+        {
+            pollLoop();
+        }
+#endif
+
+        // Fallback: compares modification times twice a second.
+        void pollLoop()
+        {
+            while( m_running.load( std::memory_order_relaxed ) )
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 500 ) );
+                for( const std::unique_ptr<WatchBase>& watch : m_watches )
+                {
+                    const std::filesystem::file_time_type time = lastWriteTime( watch->path );
+                    if( time != watch->lastWrite )
+                    {
+                        watch->lastWrite = time;
+                        reload( *watch );
+                    }
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<WatchBase>> m_watches;
+        std::thread m_thread;
+        std::atomic<bool> m_running{ false };
+
+        mutable std::mutex m_mutex;         // guards m_pending and m_error
+        std::vector<Update> m_pending;
+        std::atomic<bool> m_hasPending{ false };
+        std::string m_error;
+    };
+} // namespace ReflectiveJson
@@ -0,0 +1,283 @@
+// ReflectiveJson multi-object editing: one panel for a selection of objects of the same reflected type.
+//
+// The widgets are submitted once per field, not once per object. A field whose value differs between the selected
+// objects is shown as mixed. When a widget is edited its new value is written to every selected object by
+// applyField(): one typed loop per field over the (strided) storage, no per-object dispatch, no ImGui calls. Packed
+// values (a contiguous selection of single-field objects) are written 16 bytes at a time.
+//
+// Usage:
+//   std::vector<int> selected = ...;                           // indices into lights
+//   ReflectiveJson::DrawImGuiMulti( lights, selected );        // or DrawImGuiMulti( lights.data(), nullptr, count ) for all
+
+#pragma once
+
+#include "reflective_json.h"
+
+namespace ReflectiveJson
+{
+    // A selection inside a contiguous array of objects: base + indices[ i ] * stride, or base + i * stride for
+    // i in [0, count) when indices is null.
+    struct MultiTarget
+    {
+        char* base;
+        std::size_t stride;
+        const int* indices;
+        int count;
+
+        char* object( int i ) const { return base + (indices ? ( std::size_t )indices[ i ] : ( std::size_t )i) * stride; }
+    };
+
+    namespace detail
+    {
+        template<typename V>
+        bool allEqual( const MultiTarget& target, std::size_t offset )
+        {
+            const V& first = *reinterpret_cast< const V* >(target.object( 0 ) + offset);
+            for( int i = 1; i < target.count; i++ )
+                if( !(*reinterpret_cast< const V* >(target.object( i ) + offset) == first) )
+                    return false;
+            return true;
+        }
+
+        template<typename V>
+        void storeAll( const MultiTarget& target, std::size_t offset, const V& value )
+        {
+            if( target.indices == nullptr )
+            {
+                char* dst = target.base + offset;
+                if constexpr( std::is_trivially_copyable_v<V> && 16 % sizeof( V ) == 0 )
+                {
+                    if( target.stride == sizeof( V ) )
+                    {
+                        // Packed values (objects of a single field): the value repeated over 16 bytes, stored with
+                        // fixed-size memcpy()s that compile to one SSE2/NEON store each (4 floats per store).
+                        unsigned char pattern[ 16 ];
+                        for( std::size_t i = 0; i < sizeof( pattern ); i += sizeof( V ) )
+                            std::memcpy( pattern + i, &value, sizeof( V ) );
+                        const std::size_t bytes = ( std::size_t )target.count * sizeof( V );
+                        std::size_t i = 0;
+                        for( ; i + sizeof( pattern ) <= bytes; i += sizeof( pattern ) )
+                            std::memcpy( dst + i, pattern, sizeof( pattern ) );
+                        std::memcpy( dst + i, pattern, bytes - i );
+                        return;
+                    }
+                }
+                // One value per object, 'stride' bytes apart: packing them into a SIMD register would need a scatter
+                // store (not in SSE2/NEON), so a constant-stride scalar loop is the fast path.
+                for( int i = 0; i < target.count; i++, dst += target.stride )
+                    *reinterpret_cast< V* >(dst) = value;
+                return;
+            }
+            for( int i = 0; i < target.count; i++ )
+                *reinterpret_cast< V* >(target.base + ( std::size_t )target.indices[ i ] * target.stride + offset) = value;
+        }
+
+        inline bool vec2Equal( const ImVec2& a, const ImVec2& b ) { return a.x == b.x && a.y == b.y; }
+        inline bool vec4Equal( const ImVec4& a, const ImVec4& b ) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+    } // namespace detail
+
+    // True when every selected object holds the same value for the leaf field at 'offset' (from the object start).
+    inline bool isUniform( const MultiTarget& target, std::size_t offset, FieldKind kind )
+    {
+        if( target.count <= 1 )
+            return true;
+        switch( kind )
+        {
+        case FieldKind::Bool:       return detail::allEqual<bool>( target, offset );
+        case FieldKind::Int:        return detail::allEqual<int>( target, offset );
+        case FieldKind::Float:      return detail::allEqual<float>( target, offset );
+        case FieldKind::String:     return detail::allEqual<std::string>( target, offset );
+        case FieldKind::Texture:    return detail::allEqual<ImTextureID>( target, offset );
+        case FieldKind::Vec2:
+        {
+            const ImVec2& first = *reinterpret_cast< const ImVec2* >(target.object( 0 ) + offset);
+            for( int i = 1; i < target.count; i++ )
+                if( !detail::vec2Equal( *reinterpret_cast< const ImVec2* >(target.object( i ) + offset), first ) )
+                    return false;
+            return true;
+        }
+        case FieldKind::Vec4:
+        {
+            const ImVec4& first = *reinterpret_cast< const ImVec4* >(target.object( 0 ) + offset);
+            for( int i = 1; i < target.count; i++ )
+                if( !detail::vec4Equal( *reinterpret_cast< const ImVec4* >(target.object( i ) + offset), first ) )
+                    return false;
+            return true;
+        }
+        default:                    return false;
+        }
+    }
+
+    // Writes *value (of the field's kind) to the leaf field at 'offset' of every selected object.
+    inline bool applyField( const MultiTarget& target, std::size_t offset, FieldKind kind, const void* value )
+    {
+        switch( kind )
+        {
+        case FieldKind::Bool:       detail::storeAll( target, offset, *static_cast< const bool* >(value) ); return true;
+        case FieldKind::Int:        detail::storeAll( target, offset, *static_cast< const int* >(value) ); return true;
+        case FieldKind::Float:      detail::storeAll( target, offset, *static_cast< const float* >(value) ); return true;
+        case FieldKind::String:     detail::storeAll( target, offset, *static_cast< const std::string* >(value) ); return true;
+        case FieldKind::Texture:    detail::storeAll( target, offset, *static_cast< const ImTextureID* >(value) ); return true;
+        case FieldKind::Vec2:       detail::storeAll( target, offset, *static_cast< const ImVec2* >(value) ); return true;
+        case FieldKind::Vec4:       detail::storeAll( target, offset, *static_cast< const ImVec4* >(value) ); return true;
+        default:                    return false;
+        }
+    }
+
+    // Draws one field for the whole selection. 'offset' is the field's offset from the start of the selected objects.
+    // The widget edits a copy of the first object's value; an edit is then applied to all objects.
+    inline bool drawMultiField( const FieldMeta& field, const MultiTarget& target, std::size_t offset );
+
+    inline bool drawMultiFields( const TypeMeta& type, const MultiTarget& target, std::size_t offset, FieldMask* mask = nullptr )
+    {
+        bool changed = false;
+        for( std::size_t i = 0; i < type.fields.size(); i++ )
+        {
+            const FieldMeta& field = *type.fields[ i ];
+            if( drawMultiField( field, target, offset + field.offset ) )
+            {
+                changed = true;
+                if( mask && i < 64 )
+                    *mask |= FieldMask( 1 ) << i;
+            }
+        }
+        return changed;
+    }
+
+    inline bool drawMultiField( const FieldMeta& field, const MultiTarget& target, std::size_t offset )
+    {
+        ImGui::PushID( field.name );
+        const char* first = target.object( 0 ) + offset;
+        const bool mixed = field.kind != FieldKind::Object && !isUniform( target, offset, field.kind );
+        bool changed = false;
+        switch( field.kind )
+        {
+        case FieldKind::Bool:
+        {
+            bool value = *reinterpret_cast< const bool* >(first);
+            ImGui::PushItemFlag( ImGuiItemFlags_MixedValue, mixed );
+            changed = ImGui::Checkbox( field.name, &value );
+            ImGui::PopItemFlag();
+            if( changed )
+                applyField( target, offset, field.kind, &value );
+            break;
+        }
+        case FieldKind::Int:
+        {
+            int value = *reinterpret_cast< const int* >(first);
+            const char* format = mixed ? "(mixed)" : "%d";
+            if( field.intRange )
+                changed = ImGui::SliderInt( field.name, &value, field.intRange->first, field.intRange->second, format );
+            else
+                changed = ImGui::DragInt( field.name, &value, 1.0f, 0, 0, format );
+            if( changed )
+                applyField( target, offset, field.kind, &value );
+            break;
+        }
+        case FieldKind::Float:
+        {
+            float value = *reinterpret_cast< const float* >(first);
+            const char* format = mixed ? "(mixed)" : "%.3f";
+            if( field.floatRange )
+                changed = ImGui::SliderFloat( field.name, &value, field.floatRange->first, field.floatRange->second, format );
+            else
+                changed = ImGui::DragFloat( field.name, &value, 0.1f, 0.0f, 0.0f, format );
+            if( changed )
+                applyField( target, offset, field.kind, &value );
+            break;
+        }
+        case FieldKind::String:
+        {
+            // Copy of the shared value, in a buffer that keeps its capacity across frames
+            static std::string value;
+            if( mixed )
+                value.clear();
+            else
+                value = *reinterpret_cast< const std::string* >(first);
+            if( ImGui::InputTextWithHint( field.name, mixed ? "(mixed)" : "", &value ) )
+                changed = applyField( target, offset, field.kind, &value );
+            break;
+        }
+        case FieldKind::Vec2:
+        {
+            ImVec2 value = *reinterpret_cast< const ImVec2* >(first);
+            changed = ImGui::DragFloat2( field.name, &value.x, 1.0f, 0.0f, 0.0f, mixed ? "(mixed)" : "%.3f" );
+            if( changed )
+                applyField( target, offset, field.kind, &value );
+            break;
+        }
+        case FieldKind::Vec4:
+        {
+            ImVec4 value = *reinterpret_cast< const ImVec4* >(first);
+            changed = ImGui::ColorEdit4( field.name, &value.x,
+                ImGuiColorEditFlags_DisplayRGB |
+                ImGuiColorEditFlags_PickerHueBar |
+                ImGuiColorEditFlags_AlphaBar );
+            if( mixed )
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled( "(mixed)" );
+            }
+            if( changed )
+                applyField( target, offset, field.kind, &value );
+            break;
+        }
+        case FieldKind::Texture:
+            if( mixed )
+            {
+                ImGui::Text( "%s", field.name );
+                ImGui::TextDisabled( "(mixed)" );
+            }
+            else
+            {
+                drawTexturePreview( field.name, *reinterpret_cast< const ImTextureID* >(first) );
+            }
+            break;
+        case FieldKind::Object:
+            if( field.nested && ImGui::CollapsingHeader( field.name, nestedHeaderFlags ) )
+            {
+                ImGui::Indent();
+                changed = drawMultiFields( *field.nested, target, offset );
+                ImGui::Unindent();
+            }
+            break;
+        default:
+            ImGui::TextDisabled( "%s: not editable in a multi-selection", field.name );
+            break;
+        }
+        ImGui::PopID();
+        return changed;
+    }
+
+    // Panel editing objects[ indices[ 0 .. count ) ] (or objects[ 0 .. count ) when indices is null) at once.
+    // Returns the mask of the top-level fields that were edited.
+    template<typename T>
+    FieldMask DrawImGuiMulti( T* objects, const int* indices, int count )
+    {
+        static_assert( has_getFields_v<T>, "DrawImGuiMulti needs a reflected type" );
+        const TypeInfo& type = getTypeInfo<T>();
+        FieldMask changed = 0;
+        if( count <= 0 )
+            return changed;
+
+        ImGui::PushID( objects );
+        if( !ImGui::CollapsingHeader( type.name.data(), ImGuiTreeNodeFlags_DefaultOpen ) )
+        {
+            ImGui::PopID();
+            return changed;
+        }
+        ImGui::Indent();
+        ImGui::TextDisabled( "%d selected", count );
+        const MultiTarget target{ reinterpret_cast< char* >(objects), sizeof( T ), indices, count };
+        drawMultiFields( getTypeMeta<T>(), target, 0, &changed );
+        ImGui::Unindent();
+        ImGui::PopID();
+        return changed;
+    }
+
+    template<typename T>
+    FieldMask DrawImGuiMulti( std::vector<T>& objects, const std::vector<int>& selection )
+    {
+        return DrawImGuiMulti( objects.data(), selection.data(), ( int )selection.size() );
+    }
+} // namespace ReflectiveJson
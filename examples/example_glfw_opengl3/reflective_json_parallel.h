@@ -0,0 +1,189 @@
+// ReflectiveJson parallel serialization of large collections of reflected objects.
+//
+// The std::vector is cut into chunks of consecutive objects. Each chunk is encoded into its own buffer by a
+// JsonWriter / BinaryWriter on a thread pool, then the buffers are copied, in order and also in parallel, into one
+// output sized once: a JSON array, or a CBOR/MessagePack array (elements are self-delimiting, so concatenated
+// encodings after one array header are a valid array). The result is identical to encoding the vector on one thread.
+//
+// The calling thread takes part in the work and returns when the output is complete; the objects must not be
+// modified meanwhile.
+//
+// Usage:
+//   std::string text;
+//   ReflectiveJson::dumpJsonArray( materials, text );                       // [{...},{...},...]
+//   std::vector<std::uint8_t> bytes;
+//   ReflectiveJson::dumpBinaryArray( materials, bytes, ReflectiveJson::BinaryFormat::MsgPack );
+
+#pragma once
+
+#include "reflective_json_binary.h"
+#include "reflective_json_stream.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ReflectiveJson
+{
+    // Fixed set of worker threads running index-parallel jobs. One job at a time; run() is thread-safe.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool( unsigned threadCount = std::thread::hardware_concurrency() )
+        {
+            // The calling thread of run() is a worker too.
+            for( unsigned i = 1; i < std::max( threadCount, 1u ); i++ )
+                m_threads.emplace_back( [this]() { workerLoop(); } );
+        }
+
+        ThreadPool( const ThreadPool& ) = delete;
+        ThreadPool& operator=( const ThreadPool& ) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            for( std::thread& thread : m_threads )
+                thread.join();
+        }
+
+        unsigned threadCount() const { return ( unsigned )m_threads.size() + 1; }
+
+        // Calls task( i ) for every i in [0, count), spread over the workers and the calling thread.
+        void run( std::size_t count, const std::function<void( std::size_t )>& task )
+        {
+            if( count == 0 )
+                return;
+            std::lock_guard<std::mutex> runLock( m_runMutex );
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_task = &task;
+                m_count = count;
+                m_next.store( 0, std::memory_order_relaxed );
+                m_busy = ( unsigned )m_threads.size();
+                m_generation++;
+            }
+            m_wake.notify_all();
+            work( task, count );
+
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_done.wait( lock, [this]() { return m_busy == 0; } );
+            m_task = nullptr;
+        }
+
+    private:
+        void work( const std::function<void( std::size_t )>& task, std::size_t count )
+        {
+            for( std::size_t i = m_next.fetch_add( 1, std::memory_order_relaxed ); i < count; i = m_next.fetch_add( 1, std::memory_order_relaxed ) )
+                task( i );
+        }
+
+        void workerLoop()
+        {
+            std::uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock( m_mutex );
+            for( ;; )
+            {
+                m_wake.wait( lock, [&]() { return m_stopping || m_generation != seen; } );
+                if( m_stopping )
+                    return;
+                seen = m_generation;
+                const std::function<void( std::size_t )>& task = *m_task;
+                const std::size_t count = m_count;
+                lock.unlock();
+                work( task, count );
+                lock.lock();
+                if( --m_busy == 0 )
+                    m_done.notify_one();
+            }
+        }
+
+        std::vector<std::thread> m_threads;
+        std::mutex m_runMutex;                  // one run() at a time
+        std::mutex m_mutex;                     // guards everything below except m_next
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        const std::function<void( std::size_t )>* m_task = nullptr;
+        std::size_t m_count = 0;
+        std::atomic<std::size_t> m_next{ 0 };
+        unsigned m_busy = 0;                    // workers still on the current job
+        std::uint64_t m_generation = 0;
+        bool m_stopping = false;
+    };
+
+    // Pool shared by the collection serializers, one thread per core.
+    inline ThreadPool& defaultThreadPool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    namespace detail
+    {
+        // Appends the chunk buffers to 'out' in order: sized once, copied in parallel.
+        template<typename Buffer, typename Chunk>
+        void stitchChunks( Buffer& out, std::vector<Chunk>& chunks, std::size_t prefix, std::size_t suffix, ThreadPool& pool )
+        {
+            std::vector<std::size_t> offsets( chunks.size() + 1 );
+            offsets[ 0 ] = out.size() + prefix;
+            for( std::size_t i = 0; i < chunks.size(); i++ )
+                offsets[ i + 1 ] = offsets[ i ] + chunks[ i ].size();
+            out.resize( offsets.back() + suffix );
+            pool.run( chunks.size(), [&]( std::size_t i )
+            {
+                if( !chunks[ i ].empty() )
+                    std::memcpy( out.data() + offsets[ i ], chunks[ i ].data(), chunks[ i ].size() );
+                Chunk().swap( chunks[ i ] );
+            } );
+        }
+
+        inline std::size_t chunkCount( std::size_t objectCount, std::size_t chunkSize )
+        {
+            return (objectCount + chunkSize - 1) / chunkSize;
+        }
+    } // namespace detail
+
+    // Appends objects as one compact JSON array to a std::string or std::vector<char>.
+    template<typename T, typename Buffer>
+    void dumpJsonArray( const std::vector<T>& objects, Buffer& out, ThreadPool& pool = defaultThreadPool(), std::size_t chunkSize = 1024 )
+    {
+        std::vector<std::string> chunks( detail::chunkCount( objects.size(), chunkSize ) );
+        pool.run( chunks.size(), [&]( std::size_t c )
+        {
+            JsonWriter writer( nlohmann::detail::output_adapter<char>( chunks[ c ] ) );
+            const std::size_t begin = c * chunkSize;
+            const std::size_t end = std::min( begin + chunkSize, objects.size() );
+            for( std::size_t i = begin; i < end; i++ )
+            {
+                if( i > 0 )
+                    chunks[ c ].push_back( ',' );      // separator before every object but the first one
+                writer.writeObject( objects[ i ] );
+            }
+        } );
+        const std::size_t start = out.size();
+        detail::stitchChunks( out, chunks, 1, 1, pool );
+        out[ start ] = '[';
+        out.back() = ']';
+    }
+
+    // Appends objects as one CBOR / MessagePack array, the same bytes dumpBinary() gives for each object.
+    template<typename T>
+    void dumpBinaryArray( const std::vector<T>& objects, std::vector<std::uint8_t>& out, BinaryFormat format = BinaryFormat::Cbor,
+        ThreadPool& pool = defaultThreadPool(), std::size_t chunkSize = 1024 )
+    {
+        std::vector<std::vector<std::uint8_t>> chunks( detail::chunkCount( objects.size(), chunkSize ) );
+        pool.run( chunks.size(), [&]( std::size_t c )
+        {
+            BinaryWriter writer( nlohmann::detail::output_adapter<std::uint8_t>( chunks[ c ] ), format );
+            const std::size_t end = std::min( (c + 1) * chunkSize, objects.size() );
+            for( std::size_t i = c * chunkSize; i < end; i++ )
+                writer.writeObject( objects[ i ] );
+        } );
+        BinaryWriter( nlohmann::detail::output_adapter<std::uint8_t>( out ), format ).writeArrayHeader( objects.size() );
+        detail::stitchChunks( out, chunks, 0, 0, pool );
+    }
+} // namespace ReflectiveJson
@@ -0,0 +1,93 @@
+// ReflectiveJson incremental sync: turns the edits recorded by DrawImGui( obj, changes ) into an RFC 6902 JSON Patch.
+//
+// Only the edited leaf fields are read and serialized, so the cost is proportional to the number of edits, not to the
+// size of the object. The paths match the dumpJson() document layout, so a peer holding that document can apply the
+// patch with json::patch_inplace().
+//
+// Usage:
+//   static ReflectiveJson::ChangeList changes;
+//   if( ReflectiveJson::DrawImGui( material, changes ) )
+//   {
+//       send( ReflectiveJson::makeJsonPatch( material, changes ) );   // [{"op":"replace","path":"/owner/stats/strength","value":42}]
+//       changes.clear();
+//   }
+
+#pragma once
+
+#include "reflective_json.h"
+
+namespace ReflectiveJson
+{
+    // JSON value of a member of the given kind, same representation as dumpJson(). 'value' points at the member.
+    inline json valueToJson( FieldKind kind, const TypeMeta* nested, const VectorMeta* element, const void* value )
+    {
+        switch( kind )
+        {
+        case FieldKind::Bool:       return *static_cast< const bool* >(value);
+        case FieldKind::Int:        return *static_cast< const int* >(value);
+        case FieldKind::Float:      return *static_cast< const float* >(value);
+        case FieldKind::String:     return *static_cast< const std::string* >(value);
+        case FieldKind::Texture:    return ( std::uint64_t )*static_cast< const ImTextureID* >(value);
+        case FieldKind::Vec2:
+        {
+            const ImVec2& v = *static_cast< const ImVec2* >(value);
+            return json::array( { v.x, v.y } );
+        }
+        case FieldKind::Vec4:
+        {
+            const ImVec4& v = *static_cast< const ImVec4* >(value);
+            return json::array( { v.x, v.y, v.z, v.w } );
+        }
+        case FieldKind::Object:
+        {
+            json result = json::object();
+            if( nested )
+                for( const FieldMeta* field : nested->fields )
+                    result[ field->name ] = valueToJson( field->kind, field->nested, field->element, field->ptr( value ) );
+            return result;
+        }
+        case FieldKind::Vector:
+        {
+            json result = json::array();
+            if( element )
+                for( std::size_t i = 0, n = element->size( value ); i < n; i++ )
+                    result.push_back( valueToJson( element->elementKind, element->elementNested, nullptr, element->at_const( value, i ) ) );
+            return result;
+        }
+        default:                    return nullptr;
+        }
+    }
+
+    inline json fieldValueToJson( const FieldMeta& field, const void* value )
+    {
+        return valueToJson( field.kind, field.nested, field.element, value );
+    }
+
+    // Value of a recorded change: the field, or the edited element of a std::vector field.
+    inline json changeValueToJson( const FieldChange& change, const void* value )
+    {
+        const FieldMeta& field = *change.field;
+        if( change.elementIndex == FieldChange::npos || !field.element )
+            return fieldValueToJson( field, value );
+        if( change.elementIndex >= field.element->size( value ) )
+            return nullptr;
+        const VectorMeta& element = *field.element;
+        return valueToJson( element.elementKind, element.elementNested, nullptr, element.at_const( value, change.elementIndex ) );
+    }
+
+    // One "replace" operation per recorded change, with the current value read from obj.
+    template<typename T>
+    json makeJsonPatch( const T& obj, const ChangeList& changes )
+    {
+        json patch = json::array();
+        for( const FieldChange& change : changes.changes )
+        {
+            const void* value = reinterpret_cast< const char* >(&obj) + change.offset;
+            patch.push_back( json{
+                { "op", "replace" },
+                { "path", change.path.to_string() },
+                { "value", change.field ? changeValueToJson( change, value ) : json() } } );
+        }
+        return patch;
+    }
+} // namespace ReflectiveJson
@@ -0,0 +1,468 @@
+// ReflectiveJson records: self-describing binary records with a field offset table, for stores of many objects of
+// which readers only need a few fields.
+//
+// Record layout (little-endian):
+//   RecordHeader        magic, schema hash of the type (TypeMeta::schemaHash), total size, field count
+//   RecordEntry[ n ]    per field, in getFields() order: hash of the field name, kind, payload offset and size
+//   payloads            bool/int/float/ImVec2/ImVec4 raw, ImTextureID as 64 bits, std::string characters,
+//                       reflected members as nested records, std::vector as a count followed by the packed elements
+//                       (fixed-size kinds) or by an offset table and the elements (strings, reflected structs)
+//
+// Reading one field never decodes the rest of the record. When the record's schema hash is the reader's, a field is
+// found by its index in getFields(); otherwise (a record written by an older version of the type) by name, once per
+// schema: RecordField caches where the field sits for the last schema it saw.
+//
+// readRecord() decodes a whole record field by field: fields are matched by name, fields the record doesn't have keep
+// their current value, fields that changed between int/float/bool are clamped to their range (or to the limits of
+// the new type), then converted.
+// migrateRecord() rewrites an old record with the current schema.
+//
+// Usage:
+//   std::vector<std::uint8_t> bytes;
+//   ReflectiveJson::writeRecord( player, bytes );
+//   static ReflectiveJson::RecordField<Player> strength( "stats/strength" );
+//   int value;
+//   strength.read( ReflectiveJson::RecordView( bytes.data(), bytes.size() ), value );
+
+#pragma once
+
+#include "reflective_json.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ReflectiveJson
+{
+    struct RecordHeader
+    {
+        std::uint32_t magic;            // RecordMagic
+        ImGuiID schemaHash;
+        std::uint32_t size;             // header, entries and payloads
+        std::uint16_t fieldCount;
+        std::uint16_t version;          // RecordVersion
+    };
+
+    struct RecordEntry
+    {
+        ImGuiID nameHash;               // ImHashStr( field name )
+        std::uint32_t offset;           // payload, from the start of the record
+        std::uint32_t size;
+        std::uint8_t kind;              // FieldKind
+        std::uint8_t elementKind;       // FieldKind of the elements, for FieldKind::Vector
+        std::uint16_t reserved;
+    };
+
+    static constexpr std::uint32_t RecordMagic = 0x31524A52;     // "RJR1"
+    static constexpr std::uint16_t RecordVersion = 1;
+
+    namespace detail
+    {
+        // Payload size of the fixed-size kinds, 0 for the others.
+        inline std::uint32_t recordLeafSize( FieldKind kind )
+        {
+            switch( kind )
+            {
+            case FieldKind::Bool:       return 1;
+            case FieldKind::Int:        return 4;
+            case FieldKind::Float:      return 4;
+            case FieldKind::Vec2:       return 8;
+            case FieldKind::Vec4:       return 16;
+            case FieldKind::Texture:    return 8;
+            default:                    return 0;
+            }
+        }
+
+        inline void appendBytes( std::vector<std::uint8_t>& out, const void* data, std::size_t size )
+        {
+            const std::uint8_t* bytes = static_cast< const std::uint8_t* >(data);
+            out.insert( out.end(), bytes, bytes + size );
+        }
+
+        inline void patchBytes( std::vector<std::uint8_t>& out, std::size_t at, const void* data, std::size_t size )
+        {
+            std::memcpy( out.data() + at, data, size );
+        }
+
+        inline void writeRecordObject( const TypeMeta& type, const void* object, std::vector<std::uint8_t>& out );
+
+        inline void writeRecordValue( FieldKind kind, const TypeMeta* nested, const VectorMeta* element, const void* value, std::vector<std::uint8_t>& out )
+        {
+            switch( kind )
+            {
+            case FieldKind::Texture:
+            {
+                const std::uint64_t id = ( std::uint64_t )*static_cast< const ImTextureID* >(value);
+                appendBytes( out, &id, sizeof( id ) );
+                break;
+            }
+            case FieldKind::String:
+            {
+                const std::string& str = *static_cast< const std::string* >(value);
+                appendBytes( out, str.data(), str.size() );
+                break;
+            }
+            case FieldKind::Object:
+                if( nested )
+                    writeRecordObject( *nested, value, out );
+                break;
+            case FieldKind::Vector:
+            {
+                const std::uint32_t count = ( std::uint32_t )element->size( value );
+                appendBytes( out, &count, sizeof( count ) );
+                if( recordLeafSize( element->elementKind ) != 0 )
+                {
+                    for( std::uint32_t i = 0; i < count; i++ )
+                        writeRecordValue( element->elementKind, nullptr, nullptr, element->at_const( value, i ), out );
+                    break;
+                }
+                // Variable-size elements: offsets[ count + 1 ] from the start of the element data, then the elements.
+                const std::size_t table = out.size();
+                out.resize( table + (count + 1) * sizeof( std::uint32_t ) );
+                const std::size_t start = out.size();
+                for( std::uint32_t i = 0; i <= count; i++ )
+                {
+                    const std::uint32_t offset = ( std::uint32_t )(out.size() - start);
+                    patchBytes( out, table + i * sizeof( offset ), &offset, sizeof( offset ) );
+                    if( i < count )
+                        writeRecordValue( element->elementKind, element->elementNested, nullptr, element->at_const( value, i ), out );
+                }
+                break;
+            }
+            default:
+                appendBytes( out, value, recordLeafSize( kind ) );
+                break;
+            }
+        }
+
+        inline void writeRecordObject( const TypeMeta& type, const void* object, std::vector<std::uint8_t>& out )
+        {
+            const std::size_t start = out.size();
+            const std::size_t entries = start + sizeof( RecordHeader );
+            out.resize( entries + type.fields.size() * sizeof( RecordEntry ) );
+            for( std::size_t i = 0; i < type.fields.size(); i++ )
+            {
+                const FieldMeta& field = *type.fields[ i ];
+                RecordEntry entry{ ImHashStr( field.name ), ( std::uint32_t )(out.size() - start), 0, ( std::uint8_t )field.kind,
+                    ( std::uint8_t )(field.element ? field.element->elementKind : FieldKind::Unsupported), 0 };
+                writeRecordValue( field.kind, field.nested, field.element, field.ptr( object ), out );
+                entry.size = ( std::uint32_t )(out.size() - start) - entry.offset;
+                patchBytes( out, entries + i * sizeof( RecordEntry ), &entry, sizeof( entry ) );
+            }
+            const RecordHeader header{ RecordMagic, type.schemaHash, ( std::uint32_t )(out.size() - start), ( std::uint16_t )type.fields.size(), RecordVersion };
+            patchBytes( out, start, &header, sizeof( header ) );
+        }
+    } // namespace detail
+
+    // Appends the record of obj to 'out'.
+    template<typename T>
+    void writeRecord( const T& obj, std::vector<std::uint8_t>& out )
+    {
+        detail::writeRecordObject( getTypeMeta<T>(), &obj, out );
+    }
+
+    // ---------- Reading ----------
+    // Read-only view of one record. Checks the header and the entry table; payloads are read on demand.
+    class RecordView
+    {
+    public:
+        RecordView() = default;
+
+        RecordView( const void* data, std::size_t size )
+        {
+            RecordHeader header;
+            if( size < sizeof( header ) )
+                return;
+            std::memcpy( &header, data, sizeof( header ) );
+            if( header.magic != RecordMagic || header.version != RecordVersion || header.size > size ||
+                sizeof( header ) + ( std::size_t )header.fieldCount * sizeof( RecordEntry ) > header.size )
+                return;
+            m_data = static_cast< const std::uint8_t* >(data);
+            m_header = header;
+        }
+
+        bool valid() const              { return m_data != nullptr; }
+        ImGuiID schemaHash() const      { return m_header.schemaHash; }
+        std::size_t size() const        { return m_header.size; }
+        int fieldCount() const          { return m_header.fieldCount; }
+
+        RecordEntry entry( int index ) const
+        {
+            RecordEntry result;
+            std::memcpy( &result, m_data + sizeof( RecordHeader ) + index * sizeof( RecordEntry ), sizeof( result ) );
+            return result;
+        }
+
+        // Entry index of the field with this name hash, -1 if the record has no such field.
+        int find( ImGuiID nameHash ) const
+        {
+            for( int i = 0; i < fieldCount(); i++ )
+                if( entry( i ).nameHash == nameHash )
+                    return i;
+            return -1;
+        }
+
+        int find( std::string_view name ) const { return find( ImHashStr( name.data(), name.size() ) ); }
+
+        // Payload of an entry, null if it lies outside of the record.
+        const std::uint8_t* payload( const RecordEntry& e ) const
+        {
+            return ( std::uint64_t )e.offset + e.size <= m_header.size ? m_data + e.offset : nullptr;
+        }
+
+        // Nested record of a reflected member.
+        RecordView child( int index ) const
+        {
+            const RecordEntry e = entry( index );
+            const std::uint8_t* data = payload( e );
+            return e.kind == ( std::uint8_t )FieldKind::Object && data ? RecordView( data, e.size ) : RecordView();
+        }
+
+        // Reads a leaf, converting between int, float and bool. False if the kinds are not compatible.
+        template<typename V>
+        bool get( int index, V& out ) const
+        {
+            const RecordEntry e = entry( index );
+            const std::uint8_t* data = payload( e );
+            return data && readValue( ( FieldKind )e.kind, data, e.size, out );
+        }
+
+        template<typename V>
+        static bool readValue( FieldKind kind, const std::uint8_t* data, std::size_t size, V& out )
+        {
+            if constexpr( std::is_same_v<V, bool> || std::is_same_v<V, int> || std::is_same_v<V, float> )
+            {
+                double value;
+                if( !readNumber( kind, data, size, value ) )
+                    return false;
+                if constexpr( std::is_same_v<V, bool> )
+                    out = value != 0.0;
+                else if constexpr( std::is_same_v<V, int> )
+                    return numberToInt( value, nullptr, out );     // a float record value may not fit an int
+                else
+                    out = numberToFloat( value, nullptr );
+                return true;
+            }
+            else if constexpr( std::is_same_v<V, std::string> )
+            {
+                if( kind != FieldKind::String )
+                    return false;
+                out.assign( reinterpret_cast< const char* >(data), size );
+                return true;
+            }
+            else if constexpr( std::is_same_v<V, ImTextureID> )
+            {
+                std::uint64_t id;
+                if( kind != FieldKind::Texture || size != sizeof( id ) )
+                    return false;
+                std::memcpy( &id, data, sizeof( id ) );
+                out = ( ImTextureID )id;
+                return true;
+            }
+            else
+            {
+                static_assert( std::is_same_v<V, ImVec2> || std::is_same_v<V, ImVec4>, "unsupported record value type" );
+                if( kind != fieldKindOf<V>() || size != sizeof( V ) )
+                    return false;
+                std::memcpy( &out, data, sizeof( V ) );
+                return true;
+            }
+        }
+
+        static bool readNumber( FieldKind kind, const std::uint8_t* data, std::size_t size, double& out )
+        {
+            if( size != detail::recordLeafSize( kind ) )
+                return false;
+            switch( kind )
+            {
+            case FieldKind::Bool:   out = data[ 0 ] != 0 ? 1.0 : 0.0; return true;
+            case FieldKind::Int:    { int v; std::memcpy( &v, data, sizeof( v ) ); out = v; return true; }
+            case FieldKind::Float:  { float v; std::memcpy( &v, data, sizeof( v ) ); out = v; return true; }
+            default:                return false;
+            }
+        }
+
+    private:
+        const std::uint8_t* m_data = nullptr;
+        RecordHeader m_header{};
+    };
+
+    // A field of T, possibly nested ("owner/stats/strength"), located in records in O(1): by its index in
+    // getFields() when the record has T's schema, otherwise by name once per schema and then from a cache.
+    template<typename T>
+    class RecordField
+    {
+    public:
+        explicit RecordField( std::string_view path )
+        {
+            const TypeMeta* type = &getTypeMeta<T>();
+            while( type && !path.empty() )
+            {
+                const std::size_t slash = path.find( '/' );
+                const std::string_view name = path.substr( 0, slash );
+                Step step{ type->schemaHash, -1, ImHashStr( name.data(), name.size() ), 0, -1 };
+                for( std::size_t i = 0; i < type->fields.size(); i++ )
+                    if( name == type->fields[ i ]->name )
+                        step.index = ( int )i;
+                IM_ASSERT( step.index >= 0 && "RecordField: unknown field" );
+                m_steps.push_back( step );
+                type = step.index >= 0 ? type->fields[ step.index ]->nested : nullptr;
+                path = slash == std::string_view::npos ? std::string_view() : path.substr( slash + 1 );
+            }
+        }
+
+        // Record holding the field (the record itself, or a nested one) and the field's entry index, -1 if absent.
+        // Not thread-safe: the per-schema cache is updated when a record of another schema comes by.
+        int locate( RecordView& record ) const
+        {
+            for( std::size_t i = 0; i < m_steps.size() && record.valid(); i++ )
+            {
+                const int index = locateStep( m_steps[ i ], record );
+                if( index < 0 )
+                    return -1;
+                if( i + 1 == m_steps.size() )
+                    return index;
+                record = record.child( index );
+            }
+            return -1;
+        }
+
+        template<typename V>
+        bool read( RecordView record, V& out ) const
+        {
+            const int index = locate( record );
+            return index >= 0 && record.get( index, out );
+        }
+
+    private:
+        struct Step
+        {
+            ImGuiID schemaHash;         // type the field belongs to
+            int index;                  // in getFields()
+            ImGuiID nameHash;
+            mutable ImGuiID cachedSchema;
+            mutable int cachedIndex;    // entry index in records of cachedSchema
+        };
+
+        static int locateStep( const Step& step, const RecordView& record )
+        {
+            const ImGuiID schema = record.schemaHash();
+            if( schema == step.schemaHash )
+                return step.index < record.fieldCount() ? step.index : -1;
+            if( schema != step.cachedSchema || step.cachedIndex >= record.fieldCount() )
+            {
+                step.cachedSchema = schema;
+                step.cachedIndex = record.find( step.nameHash );
+            }
+            return step.cachedIndex;
+        }
+
+        std::vector<Step> m_steps;
+    };
+
+    namespace detail
+    {
+        inline bool readRecordObject( const TypeMeta& type, const RecordView& record, void* object );
+
+        template<typename V>
+        bool readRecordNumber( const FieldMeta* field, FieldKind kind, const std::uint8_t* data, std::size_t size, V& out )
+        {
+            if constexpr( std::is_same_v<V, bool> )
+                return RecordView::readValue( kind, data, size, out );
+            double value;
+            if( !RecordView::readNumber( kind, data, size, value ) )
+                return false;
+            if constexpr( std::is_same_v<V, int> )
+                return numberToInt( value, field, out );      // clamped to the field's range before the conversion
+            else
+                out = numberToFloat( value, field );
+            return true;
+        }
+
+        // Decodes a payload of kind 'from' into a member of kind 'to'. 'field' is the member (ranges), null for
+        // std::vector elements.
+        inline bool readRecordValue( const FieldMeta* field, FieldKind to, const TypeMeta* nested, const VectorMeta* element,
+            FieldKind from, FieldKind fromElement, const std::uint8_t* data, std::size_t size, void* value )
+        {
+            switch( to )
+            {
+            case FieldKind::Bool:       return readRecordNumber( field, from, data, size, *static_cast< bool* >(value) );
+            case FieldKind::Int:        return readRecordNumber( field, from, data, size, *static_cast< int* >(value) );
+            case FieldKind::Float:      return readRecordNumber( field, from, data, size, *static_cast< float* >(value) );
+            case FieldKind::Vec2:       return RecordView::readValue( from, data, size, *static_cast< ImVec2* >(value) );
+            case FieldKind::Vec4:       return RecordView::readValue( from, data, size, *static_cast< ImVec4* >(value) );
+            case FieldKind::Texture:    return RecordView::readValue( from, data, size, *static_cast< ImTextureID* >(value) );
+            case FieldKind::String:     return RecordView::readValue( from, data, size, *static_cast< std::string* >(value) );
+            case FieldKind::Object:
+                return from == FieldKind::Object && nested && readRecordObject( *nested, RecordView( data, size ), value );
+            case FieldKind::Vector:
+            {
+                std::uint32_t count;
+                if( from != FieldKind::Vector || size < sizeof( count ) )
+                    return false;
+                std::memcpy( &count, data, sizeof( count ) );
+                data += sizeof( count );
+                size -= sizeof( count );
+                const std::uint32_t stride = recordLeafSize( fromElement );
+                if( stride != 0 ? count > size / stride : count >= size / sizeof( std::uint32_t ) )
+                    return false;
+                element->resize( value, count );
+                const std::uint8_t* elements = data + (stride != 0 ? 0 : (count + 1) * sizeof( std::uint32_t ));
+                const std::size_t elementsSize = size - (elements - data);
+                for( std::uint32_t i = 0; i < count; i++ )
+                {
+                    std::uint32_t begin = i * stride, end = begin + stride;
+                    if( stride == 0 )
+                    {
+                        std::memcpy( &begin, data + i * sizeof( begin ), sizeof( begin ) );
+                        std::memcpy( &end, data + (i + 1) * sizeof( end ), sizeof( end ) );
+                        if( begin > end || end > elementsSize )
+                            return false;
+                    }
+                    readRecordValue( nullptr, element->elementKind, element->elementNested, nullptr, fromElement, FieldKind::Unsupported,
+                        elements + begin, end - begin, element->at( value, i ) );
+                }
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        inline bool readRecordObject( const TypeMeta& type, const RecordView& record, void* object )
+        {
+            if( !record.valid() )
+                return false;
+            const bool sameSchema = record.schemaHash() == type.schemaHash && record.fieldCount() == ( int )type.fields.size();
+            for( std::size_t i = 0; i < type.fields.size(); i++ )
+            {
+                const FieldMeta& field = *type.fields[ i ];
+                const int index = sameSchema ? ( int )i : record.find( std::string_view( field.name ) );
+                if( index < 0 )
+                    continue;
+                const RecordEntry e = record.entry( index );
+                if( const std::uint8_t* data = record.payload( e ) )
+                    readRecordValue( &field, field.kind, field.nested, field.element, ( FieldKind )e.kind, ( FieldKind )e.elementKind,
+                        data, e.size, field.ptr( object ) );
+            }
+            return true;
+        }
+    } // namespace detail
+
+    // Decodes a record into obj, migrating it field by field if it was written with another schema of T.
+    template<typename T>
+    bool readRecord( T& obj, const void* data, std::size_t size )
+    {
+        return detail::readRecordObject( getTypeMeta<T>(), RecordView( data, size ), &obj );
+    }
+
+    // Rewrites a record of an older schema of T with the current one. Fields the old record doesn't have get the
+    // value of a default-constructed T.
+    template<typename T>
+    bool migrateRecord( const void* data, std::size_t size, std::vector<std::uint8_t>& out )
+    {
+        T obj{};
+        if( !readRecord( obj, data, size ) )
+            return false;
+        writeRecord( obj, out );
+        return true;
+    }
+} // namespace ReflectiveJson
@@ -0,0 +1,988 @@
+// ReflectiveJson remote inspector: a headless process serves a std::vector of reflected objects over a local socket,
+// a GUI process (this example) mirrors them, draws them with DrawImGui() and sends the edits back.
+//
+// - Endpoints: "127.0.0.1:7777" (TCP) or "unix:/tmp/service.sock" (Unix domain socket, not on Windows).
+// - Both sides compile the same reflected type; the connection is refused when their schema hashes differ.
+// - The server keeps, per client, a shadow copy of what it sent. Each poll() compares the objects with it leaf by
+//   leaf (whole trivially copyable objects first, with one memcmp) and sends only the leaves that changed: object
+//   index gaps, leaf indices and values are varint-coded. A frame is only built when the client has read the
+//   previous ones, so a slow client gets fewer, larger frames with the changes coalesced.
+// - Client edits carry an increasing sequence number and frames report the last one applied: until then the
+//   client ignores incoming values of the leaves it edited, so a frame sent before the edit does not undo it.
+//
+// Leaves: bool, int, float, ImVec2, ImVec4, ImTextureID, std::string, nested reflected objects, and std::vector of
+// those leaf kinds (std::vector of reflected objects is not streamed).
+//
+// Wire format (per message): u32 payload size, u8 type, payload.
+//   Hello (server):  u32 schema hash, varint leaf count
+//   Frame (server):  varint last applied edit, varint object count, varint group count, groups
+//   Edit (client):   varint edit sequence number, varint group count, groups
+//   group:           varint object index gap (from the previous group's object + 1), varint change count, changes
+//   change:          varint leaf index, [vector leaves: varint 0 + varint new size, or element index + 1], value
+//
+// Usage:
+//   // service, on the thread owning 'lights':
+//   static ReflectiveJson::RemoteServer<Light> server;
+//   server.listen( "127.0.0.1:7777" );
+//   server.poll( lights );                         // every tick: applies edits, sends what changed
+//   // GUI, every frame:
+//   static ReflectiveJson::RemoteClient<Light> client;
+//   client.poll();
+//   static ReflectiveJson::ChangeList changes;
+//   for( std::size_t i = 0; i < client.objects().size(); i++ )
+//       if( ReflectiveJson::DrawImGui( client.objects()[ i ], changes ) )
+//       {
+//           client.sendEdits( i, changes );
+//           changes.clear();
+//       }
+
+#pragma once
+
+#include "reflective_json.h"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32")
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace ReflectiveJson
+{
+    // Traffic of one RemoteServer / RemoteClient since it was created.
+    struct RemoteStats
+    {
+        std::uint64_t bytesSent = 0;
+        std::uint64_t bytesReceived = 0;
+        std::uint64_t messagesSent = 0;
+        std::uint64_t changesSent = 0;      // leaf values
+        std::uint64_t changesReceived = 0;
+    };
+
+    namespace detail
+    {
+        enum class RemoteMessage : std::uint8_t
+        {
+            Hello = 1,
+            Frame = 2,
+            Edit = 3,
+        };
+
+        constexpr std::uint32_t RemoteMaxMessage = 256u << 20;
+
+        // ---------- Sockets ----------
+#ifdef _WIN32
+        using SocketHandle = SOCKET;
+        constexpr SocketHandle InvalidSocket = INVALID_SOCKET;
+        inline void closeSocket( SocketHandle s ) { closesocket( s ); }
+        inline bool socketWouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+        inline bool setNonBlocking( SocketHandle s ) { u_long on = 1; return ioctlsocket( s, FIONBIO, &on ) == 0; }
+        inline bool initSockets()
+        {
+            static const bool ok = []() { WSADATA data; return WSAStartup( MAKEWORD( 2, 2 ), &data ) == 0; }();
+            return ok;
+        }
+        constexpr int SendFlags = 0;
+#else
+        using SocketHandle = int;
+        constexpr SocketHandle InvalidSocket = -1;
+        inline void closeSocket( SocketHandle s ) { ::close( s ); }
+        inline bool socketWouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+        inline bool setNonBlocking( SocketHandle s ) { return fcntl( s, F_SETFL, fcntl( s, F_GETFL, 0 ) | O_NONBLOCK ) == 0; }
+        inline bool initSockets() { return true; }
+#ifdef MSG_NOSIGNAL
+        constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+        constexpr int SendFlags = 0;
+#endif
+#endif
+
+        // "unix:/path" or "host:port" -> socket address.
+        struct RemoteAddress
+        {
+            sockaddr_storage storage{};
+            socklen_t length = 0;
+            int family = AF_INET;
+        };
+
+        inline bool parseEndpoint( const std::string& endpoint, RemoteAddress& address, std::string* error )
+        {
+            address = RemoteAddress();
+            if( endpoint.compare( 0, 5, "unix:" ) == 0 )
+            {
+#ifdef _WIN32
+                if( error )
+                    *error = "Unix domain sockets are not supported on this platform";
+                return false;
+#else
+                sockaddr_un* un = reinterpret_cast< sockaddr_un* >(&address.storage);
+                const std::string path = endpoint.substr( 5 );
+                if( path.empty() || path.size() >= sizeof( un->sun_path ) )
+                {
+                    if( error )
+                        *error = "Invalid socket path: " + path;
+                    return false;
+                }
+                un->sun_family = AF_UNIX;
+                std::memcpy( un->sun_path, path.c_str(), path.size() + 1 );
+                address.length = ( socklen_t )sizeof( sockaddr_un );
+                address.family = AF_UNIX;
+                return true;
+#endif
+            }
+            const std::size_t colon = endpoint.rfind( ':' );
+            sockaddr_in* in = reinterpret_cast< sockaddr_in* >(&address.storage);
+            in->sin_family = AF_INET;
+            const int port = colon == std::string::npos ? 0 : atoi( endpoint.c_str() + colon + 1 );
+            const std::string host = colon == std::string::npos ? endpoint : endpoint.substr( 0, colon );
+            if( port <= 0 || port > 65535 || inet_pton( AF_INET, host.empty() ? "127.0.0.1" : host.c_str(), &in->sin_addr ) != 1 )
+            {
+                if( error )
+                    *error = "Invalid endpoint: " + endpoint + " (expected host:port or unix:/path)";
+                return false;
+            }
+            in->sin_port = htons( ( unsigned short )port );
+            address.length = ( socklen_t )sizeof( sockaddr_in );
+            return true;
+        }
+
+        // Non-blocking, no Nagle delay for small frames, no SIGPIPE when the peer went away.
+        inline void configureSocket( SocketHandle s, int family )
+        {
+            setNonBlocking( s );
+            int on = 1;
+            if( family == AF_INET )
+                setsockopt( s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast< const char* >(&on), sizeof( on ) );
+#ifdef SO_NOSIGPIPE
+            setsockopt( s, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof( on ) );
+#endif
+        }
+
+        // Non-blocking connection with its unsent output and its incomplete input.
+        class RemoteConnection
+        {
+        public:
+            RemoteConnection() = default;
+            explicit RemoteConnection( SocketHandle s ) : m_socket( s ) {}
+            RemoteConnection( const RemoteConnection& ) = delete;
+            RemoteConnection& operator=( const RemoteConnection& ) = delete;
+            ~RemoteConnection() { close(); }
+
+            bool open() const { return m_socket != InvalidSocket; }
+
+            void close()
+            {
+                if( m_socket != InvalidSocket )
+                    closeSocket( m_socket );
+                m_socket = InvalidSocket;
+                m_output.clear();
+                m_outputSent = 0;
+                m_inputEnd = 0;
+                m_inputRead = 0;
+            }
+
+            // Bytes queued and not yet accepted by the socket.
+            std::size_t backlog() const { return m_output.size() - m_outputSent; }
+
+            // Appends a message to the output; finishMessage() writes its size.
+            std::vector<std::uint8_t>& beginMessage( RemoteMessage type )
+            {
+                m_messageStart = m_output.size();
+                m_output.resize( m_messageStart + 5 );
+                m_output[ m_messageStart + 4 ] = ( std::uint8_t )type;
+                return m_output;
+            }
+
+            void finishMessage( RemoteStats& stats )
+            {
+                const std::uint32_t size = ( std::uint32_t )(m_output.size() - m_messageStart - 5);
+                for( int i = 0; i < 4; i++ )
+                    m_output[ m_messageStart + i ] = ( std::uint8_t )(size >> (8 * i));
+                stats.messagesSent++;
+            }
+
+            // Sends as much of the output as the socket takes. False when the connection is lost.
+            bool flush( RemoteStats& stats )
+            {
+                while( open() && m_outputSent < m_output.size() )
+                {
+                    const int sent = ( int )send( m_socket, reinterpret_cast< const char* >(m_output.data() + m_outputSent),
+                        ( int )ImMin( m_output.size() - m_outputSent, ( std::size_t )(1 << 20) ), SendFlags );
+                    if( sent < 0 && socketWouldBlock() )
+                        break;
+                    if( sent <= 0 )
+                    {
+                        close();
+                        return false;
+                    }
+                    m_outputSent += ( std::size_t )sent;
+                    stats.bytesSent += ( std::uint64_t )sent;
+                }
+                if( m_outputSent == m_output.size() )
+                {
+                    m_output.clear();               // keeps the capacity
+                    m_outputSent = 0;
+                }
+                return open();
+            }
+
+            // Reads what the socket has. False when the connection is lost.
+            bool receive( RemoteStats& stats )
+            {
+                // Drop the messages already read; the buffer itself only grows
+                if( m_inputRead > 0 )
+                {
+                    std::memmove( m_input.data(), m_input.data() + m_inputRead, m_inputEnd - m_inputRead );
+                    m_inputEnd -= m_inputRead;
+                    m_inputRead = 0;
+                }
+                while( open() )
+                {
+                    if( m_input.size() - m_inputEnd < ReadSize )
+                        m_input.resize( m_inputEnd + ReadSize );
+                    const int received = ( int )recv( m_socket, reinterpret_cast< char* >(m_input.data() + m_inputEnd), ( int )(m_input.size() - m_inputEnd), 0 );
+                    if( received < 0 && socketWouldBlock() )
+                        break;
+                    if( received <= 0 )
+                    {
+                        close();
+                        return false;
+                    }
+                    m_inputEnd += ( std::size_t )received;
+                    stats.bytesReceived += ( std::uint64_t )received;
+                }
+                return open();
+            }
+
+            // Next complete message, if any. The payload stays valid until the next receive().
+            bool nextMessage( RemoteMessage& type, const std::uint8_t*& payload, std::size_t& size )
+            {
+                const std::size_t available = m_inputEnd - m_inputRead;
+                if( available < 5 )
+                    return false;
+                const std::uint8_t* header = m_input.data() + m_inputRead;
+                const std::uint32_t length = ( std::uint32_t )header[ 0 ] | (( std::uint32_t )header[ 1 ] << 8) |
+                    (( std::uint32_t )header[ 2 ] << 16) | (( std::uint32_t )header[ 3 ] << 24);
+                if( length > RemoteMaxMessage )
+                {
+                    close();
+                    return false;
+                }
+                if( available < 5 + ( std::size_t )length )
+                    return false;
+                type = ( RemoteMessage )header[ 4 ];
+                payload = header + 5;
+                size = length;
+                m_inputRead += 5 + ( std::size_t )length;
+                return true;
+            }
+
+        private:
+            static constexpr std::size_t ReadSize = 64 * 1024;
+
+            SocketHandle m_socket = InvalidSocket;
+            std::vector<std::uint8_t> m_output;
+            std::size_t m_outputSent = 0;
+            std::size_t m_messageStart = 0;
+            std::vector<std::uint8_t> m_input;
+            std::size_t m_inputEnd = 0;     // received bytes in m_input
+            std::size_t m_inputRead = 0;    // of which already returned by nextMessage()
+        };
+
+        // ---------- Encoding ----------
+        inline void putVarint( std::vector<std::uint8_t>& out, std::uint64_t value )
+        {
+            while( value >= 0x80 )
+            {
+                out.push_back( ( std::uint8_t )(value | 0x80) );
+                value >>= 7;
+            }
+            out.push_back( ( std::uint8_t )value );
+        }
+
+        struct RemoteReader
+        {
+            const std::uint8_t* data;
+            std::size_t size;
+            std::size_t pos = 0;
+            bool failed = false;
+
+            std::uint64_t varint()
+            {
+                std::uint64_t value = 0;
+                for( int shift = 0; shift < 64; shift += 7 )
+                {
+                    if( pos >= size )
+                        break;
+                    const std::uint8_t byte = data[ pos++ ];
+                    value |= ( std::uint64_t )(byte & 0x7F) << shift;
+                    if( !(byte & 0x80) )
+                        return value;
+                }
+                failed = true;
+                return 0;
+            }
+
+            const std::uint8_t* bytes( std::size_t count )
+            {
+                if( failed || size - pos < count )
+                {
+                    failed = true;
+                    return nullptr;
+                }
+                pos += count;
+                return data + pos - count;
+            }
+        };
+
+        // One streamed leaf of a type: a member of a leaf kind, or a std::vector of a leaf kind, at any depth.
+        struct RemoteLeaf
+        {
+            std::size_t offset;             // from the start of the root object
+            const FieldMeta* field;
+            FieldKind kind;                 // of the value, or of the elements for a vector
+            bool vector;
+        };
+
+        inline bool isRemoteLeafKind( FieldKind kind )
+        {
+            return kind == FieldKind::String || leafSize( kind ) > 0;
+        }
+
+        inline void appendRemoteLeaves( const TypeMeta& type, std::size_t offset, std::vector<RemoteLeaf>& out )
+        {
+            for( const FieldMeta* field : type.fields )
+            {
+                if( field->kind == FieldKind::Object && field->nested )
+                    appendRemoteLeaves( *field->nested, offset + field->offset, out );
+                else if( field->kind == FieldKind::Vector && field->element && isRemoteLeafKind( field->element->elementKind ) )
+                    out.push_back( RemoteLeaf{ offset + field->offset, field, field->element->elementKind, true } );
+                else if( isRemoteLeafKind( field->kind ) )
+                    out.push_back( RemoteLeaf{ offset + field->offset, field, field->kind, false } );
+            }
+        }
+
+        struct RemoteLayout
+        {
+            std::vector<RemoteLeaf> leaves;
+            std::unordered_map<std::size_t, std::uint32_t> leafAtOffset;
+        };
+
+        template<typename T>
+        const RemoteLayout& getRemoteLayout()
+        {
+            static const RemoteLayout layout = []()
+            {
+                RemoteLayout result;
+                appendRemoteLeaves( getTypeMeta<T>(), 0, result.leaves );
+                for( std::uint32_t i = 0; i < ( std::uint32_t )result.leaves.size(); i++ )
+                    result.leafAtOffset[ result.leaves[ i ].offset ] = i;
+                return result;
+            }();
+            return layout;
+        }
+
+        inline bool sameValue( FieldKind kind, const void* a, const void* b )
+        {
+            if( kind == FieldKind::String )
+                return *static_cast< const std::string* >(a) == *static_cast< const std::string* >(b);
+            return std::memcmp( a, b, leafSize( kind ) ) == 0;
+        }
+
+        inline void copyValue( FieldKind kind, void* dst, const void* src )
+        {
+            if( kind == FieldKind::String )
+                *static_cast< std::string* >(dst) = *static_cast< const std::string* >(src);
+            else
+                std::memcpy( dst, src, leafSize( kind ) );
+        }
+
+        inline void putValue( std::vector<std::uint8_t>& out, FieldKind kind, const void* value )
+        {
+            switch( kind )
+            {
+            case FieldKind::Bool:
+                out.push_back( *static_cast< const bool* >(value) ? 1 : 0 );
+                break;
+            case FieldKind::Int:
+            {
+                const std::int64_t v = *static_cast< const int* >(value);
+                putVarint( out, (( std::uint64_t )v << 1) ^ ( std::uint64_t )(v >> 63) );     // zigzag: small magnitudes stay short
+                break;
+            }
+            case FieldKind::String:
+            {
+                const std::string& text = *static_cast< const std::string* >(value);
+                putVarint( out, text.size() );
+                out.insert( out.end(), text.begin(), text.end() );
+                break;
+            }
+            default:
+            {
+                const std::uint8_t* bytes = static_cast< const std::uint8_t* >(value);
+                out.insert( out.end(), bytes, bytes + leafSize( kind ) );
+                break;
+            }
+            }
+        }
+
+        // Reads one value into 'value', or skips it when value is null.
+        inline bool getValue( RemoteReader& in, FieldKind kind, void* value )
+        {
+            switch( kind )
+            {
+            case FieldKind::Bool:
+            {
+                const std::uint8_t* byte = in.bytes( 1 );
+                if( byte && value )
+                    *static_cast< bool* >(value) = *byte != 0;
+                break;
+            }
+            case FieldKind::Int:
+            {
+                const std::uint64_t v = in.varint();
+                if( value )
+                    *static_cast< int* >(value) = ( int )( std::int64_t )((v >> 1) ^ (~(v & 1) + 1));
+                break;
+            }
+            case FieldKind::String:
+            {
+                const std::size_t length = ( std::size_t )in.varint();
+                const std::uint8_t* chars = in.bytes( length );
+                if( chars && value )
+                    static_cast< std::string* >(value)->assign( reinterpret_cast< const char* >(chars), length );
+                break;
+            }
+            default:
+            {
+                const std::uint8_t* bytes = in.bytes( leafSize( kind ) );
+                if( bytes && value )
+                    std::memcpy( value, bytes, leafSize( kind ) );
+                break;
+            }
+            }
+            return !in.failed;
+        }
+
+        // Slot of a vector leaf: 0 = its size, n = element n - 1.
+        inline void* remoteSlot( void* root, const RemoteLeaf& leaf, std::size_t slot )
+        {
+            void* member = static_cast< char* >(root) + leaf.offset;
+            if( !leaf.vector )
+                return member;
+            if( slot == 0 || slot - 1 >= leaf.field->element->size( member ) )
+                return nullptr;
+            return leaf.field->element->at( member, slot - 1 );
+        }
+
+        // Appends the changes of 'object' against 'shadow' to 'out' and updates the shadow. Returns the change count.
+        inline std::uint32_t diffObject( const RemoteLayout& layout, const void* object, void* shadow, std::vector<std::uint8_t>& out )
+        {
+            std::uint32_t changes = 0;
+            for( std::uint32_t i = 0; i < ( std::uint32_t )layout.leaves.size(); i++ )
+            {
+                const RemoteLeaf& leaf = layout.leaves[ i ];
+                const void* value = static_cast< const char* >(object) + leaf.offset;
+                void* sent = static_cast< char* >(shadow) + leaf.offset;
+                if( !leaf.vector )
+                {
+                    if( sameValue( leaf.kind, value, sent ) )
+                        continue;
+                    putVarint( out, i );
+                    putValue( out, leaf.kind, value );
+                    copyValue( leaf.kind, sent, value );
+                    changes++;
+                    continue;
+                }
+                const VectorMeta& element = *leaf.field->element;
+                const std::size_t count = element.size( value );
+                const std::size_t sentCount = element.size( sent );
+                if( count != sentCount )
+                {
+                    putVarint( out, i );
+                    putVarint( out, 0 );
+                    putVarint( out, count );
+                    element.resize( sent, count );
+                    changes++;
+                }
+                for( std::size_t e = 0; e < count; e++ )
+                {
+                    const void* item = element.at_const( value, e );
+                    void* sentItem = element.at( sent, e );
+                    if( e < sentCount && sameValue( leaf.kind, item, sentItem ) )
+                        continue;
+                    putVarint( out, i );
+                    putVarint( out, e + 1 );
+                    putValue( out, leaf.kind, item );
+                    copyValue( leaf.kind, sentItem, item );
+                    changes++;
+                }
+            }
+            return changes;
+        }
+
+        // Change to a leaf of an object as it comes off the wire: where it goes, already decoded into the object when
+        // 'apply' returned true.
+        struct RemoteChange
+        {
+            std::size_t object;
+            std::uint32_t leaf;
+            std::size_t slot;
+        };
+
+        // Reads 'groupCount' groups. For every change, accept( change ) returns the object to decode it into, or null
+        // to skip the value; applied( change ) is called after a value was written. False on malformed input.
+        template<typename Accept, typename Applied>
+        bool readGroups( RemoteReader& in, const RemoteLayout& layout, Accept&& accept, Applied&& applied )
+        {
+            const std::uint64_t groups = in.varint();
+            std::size_t object = 0;
+            for( std::uint64_t g = 0; g < groups && !in.failed; g++ )
+            {
+                object += ( std::size_t )in.varint() + (g > 0 ? 1 : 0);
+                const std::uint64_t changes = in.varint();
+                for( std::uint64_t c = 0; c < changes && !in.failed; c++ )
+                {
+                    const std::uint64_t leafIndex = in.varint();
+                    if( leafIndex >= layout.leaves.size() )
+                        return false;
+                    const RemoteLeaf& leaf = layout.leaves[ ( std::size_t )leafIndex ];
+                    RemoteChange change{ object, ( std::uint32_t )leafIndex, leaf.vector ? ( std::size_t )in.varint() : 0 };
+                    void* root = accept( change );
+                    if( leaf.vector && change.slot == 0 )
+                    {
+                        // A vector that grows is followed by the values of its new elements, at least one byte each:
+                        // growth beyond the bytes left in the message is malformed, and would let a peer allocate at will.
+                        // Skipped resizes allocate nothing and are not checked.
+                        const std::uint64_t count = in.varint();
+                        void* vector = root ? static_cast< char* >(root) + leaf.offset : nullptr;
+                        const std::size_t current = vector ? leaf.field->element->size( vector ) : 0;
+                        if( vector && count > current && count - current > in.size - in.pos )
+                            return false;
+                        if( vector )
+                        {
+                            leaf.field->element->resize( vector, ( std::size_t )count );
+                            applied( change );
+                        }
+                        continue;
+                    }
+                    void* value = root ? remoteSlot( root, leaf, change.slot ) : nullptr;
+                    if( !getValue( in, leaf.kind, value ) )
+                        return false;
+                    if( value )
+                        applied( change );
+                }
+            }
+            return !in.failed;
+        }
+    } // namespace detail
+
+    // Serves objects to RemoteClient<T>s. Not thread-safe: call everything from the thread that owns the objects.
+    template<typename T>
+    class RemoteServer
+    {
+    public:
+        // Frames are held back while a client has more than this many unsent bytes.
+        std::size_t maxBacklog = 4u << 20;
+
+        RemoteServer() = default;
+        RemoteServer( const RemoteServer& ) = delete;
+        RemoteServer& operator=( const RemoteServer& ) = delete;
+        ~RemoteServer() { close(); }
+
+        bool listen( const std::string& endpoint, std::string* error = nullptr )
+        {
+            close();
+            detail::RemoteAddress address;
+            if( !detail::initSockets() || !detail::parseEndpoint( endpoint, address, error ) )
+                return false;
+#ifndef _WIN32
+            if( address.family == AF_UNIX )
+                ::unlink( reinterpret_cast< sockaddr_un* >(&address.storage)->sun_path );
+#endif
+            m_listener = socket( address.family, SOCK_STREAM, 0 );
+            int on = 1;
+            if( m_listener != detail::InvalidSocket && address.family == AF_INET )
+                setsockopt( m_listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast< const char* >(&on), sizeof( on ) );
+            if( m_listener == detail::InvalidSocket || bind( m_listener, reinterpret_cast< sockaddr* >(&address.storage), address.length ) != 0 ||
+                ::listen( m_listener, 8 ) != 0 || !detail::setNonBlocking( m_listener ) )
+            {
+                if( error )
+                    *error = "Cannot listen on " + endpoint;
+                close();
+                return false;
+            }
+            m_family = address.family;
+            m_endpoint = endpoint;
+            return true;
+        }
+
+        bool listening() const { return m_listener != detail::InvalidSocket; }
+        std::size_t clientCount() const { return m_clients.size(); }
+        const RemoteStats& stats() const { return m_stats; }
+
+        void close()
+        {
+            m_clients.clear();
+            if( m_listener != detail::InvalidSocket )
+            {
+                detail::closeSocket( m_listener );
+#ifndef _WIN32
+                if( m_family == AF_UNIX )
+                    ::unlink( m_endpoint.c_str() + 5 );
+#endif
+            }
+            m_listener = detail::InvalidSocket;
+        }
+
+        // Accepts new clients, applies their edits to 'objects', then sends each client what changed since its last
+        // frame. Returns the number of leaf values edited by clients.
+        int poll( std::vector<T>& objects )
+        {
+            accept();
+            int edits = 0;
+            for( std::size_t c = 0; c < m_clients.size(); )
+            {
+                Client& client = *m_clients[ c ];
+                if( client.connection.receive( m_stats ) )
+                    edits += readEdits( client, objects );
+                if( client.connection.open() && client.connection.backlog() <= maxBacklog )
+                    sendFrame( client, objects );
+                if( !client.connection.flush( m_stats ) )
+                {
+                    m_clients.erase( m_clients.begin() + ( std::ptrdiff_t )c );
+                    continue;
+                }
+                c++;
+            }
+            return edits;
+        }
+
+    private:
+        struct Client
+        {
+            detail::RemoteConnection connection;
+            std::vector<T> shadow;          // the objects as this client last received them
+            std::uint64_t appliedEdit = 0;  // last edit sequence number applied
+            std::uint64_t ackedEdit = 0;    // last one reported in a frame
+
+            explicit Client( detail::SocketHandle s ) : connection( s ) {}
+        };
+
+        void accept()
+        {
+            if( m_listener == detail::InvalidSocket )
+                return;
+            for( ;; )
+            {
+                const detail::SocketHandle s = ::accept( m_listener, nullptr, nullptr );
+                if( s == detail::InvalidSocket )
+                    return;
+                detail::configureSocket( s, m_family );
+                m_clients.push_back( std::make_unique<Client>( s ) );
+                std::vector<std::uint8_t>& out = m_clients.back()->connection.beginMessage( detail::RemoteMessage::Hello );
+                const std::uint32_t hash = getTypeMeta<T>().schemaHash;
+                for( int i = 0; i < 4; i++ )
+                    out.push_back( ( std::uint8_t )(hash >> (8 * i)) );
+                detail::putVarint( out, detail::getRemoteLayout<T>().leaves.size() );
+                m_clients.back()->connection.finishMessage( m_stats );
+            }
+        }
+
+        int readEdits( Client& client, std::vector<T>& objects )
+        {
+            const detail::RemoteLayout& layout = detail::getRemoteLayout<T>();
+            int edits = 0;
+            detail::RemoteMessage type;
+            const std::uint8_t* payload;
+            std::size_t size;
+            while( client.connection.nextMessage( type, payload, size ) )
+            {
+                if( type != detail::RemoteMessage::Edit )
+                    continue;
+                detail::RemoteReader in{ payload, size };
+                const std::uint64_t seq = in.varint();
+                const bool ok = detail::readGroups( in, layout,
+                    [&]( const detail::RemoteChange& change ) -> void* { return change.object < objects.size() ? &objects[ change.object ] : nullptr; },
+                    [&]( const detail::RemoteChange& change )
+                    {
+                        // The client already shows this value: record it as sent, so that it is not echoed back
+                        edits++;
+                        m_stats.changesReceived++;
+                        if( change.object >= client.shadow.size() )
+                            return;
+                        const detail::RemoteLeaf& leaf = layout.leaves[ change.leaf ];
+                        void* object = &objects[ change.object ];
+                        void* shadow = &client.shadow[ change.object ];
+                        if( leaf.vector && change.slot == 0 )
+                            leaf.field->element->resize( static_cast< char* >(shadow) + leaf.offset, leaf.field->element->size( static_cast< char* >(object) + leaf.offset ) );
+                        else if( void* sent = detail::remoteSlot( shadow, leaf, change.slot ) )
+                            detail::copyValue( leaf.kind, sent, detail::remoteSlot( object, leaf, change.slot ) );
+                    } );
+                if( !ok )
+                {
+                    client.connection.close();
+                    break;
+                }
+                client.appliedEdit = ImMax( client.appliedEdit, seq );
+            }
+            return edits;
+        }
+
+        void sendFrame( Client& client, const std::vector<T>& objects )
+        {
+            const detail::RemoteLayout& layout = detail::getRemoteLayout<T>();
+            const std::size_t sentCount = client.shadow.size();
+            const std::size_t known = ImMin( sentCount, objects.size() );
+            client.shadow.resize( objects.size() );             // new objects are diffed against default-constructed ones
+
+            m_groups.clear();
+            std::uint64_t groupCount = 0;
+            std::size_t nextObject = 0;
+            std::uint64_t changes = 0;
+            for( std::size_t i = 0; i < objects.size(); i++ )
+            {
+                if constexpr( std::is_trivially_copyable_v<T> )
+                    if( i < known && std::memcmp( &objects[ i ], &client.shadow[ i ], sizeof( T ) ) == 0 )
+                        continue;
+                m_changes.clear();
+                const std::uint32_t count = detail::diffObject( layout, &objects[ i ], &client.shadow[ i ], m_changes );
+                if( count == 0 )
+                    continue;
+                detail::putVarint( m_groups, i - nextObject );
+                detail::putVarint( m_groups, count );
+                m_groups.insert( m_groups.end(), m_changes.begin(), m_changes.end() );
+                nextObject = i + 1;
+                groupCount++;
+                changes += count;
+            }
+            if( groupCount == 0 && sentCount == objects.size() && client.appliedEdit == client.ackedEdit )
+                return;                                          // nothing to say
+
+            std::vector<std::uint8_t>& out = client.connection.beginMessage( detail::RemoteMessage::Frame );
+            detail::putVarint( out, client.appliedEdit );
+            detail::putVarint( out, objects.size() );
+            detail::putVarint( out, groupCount );
+            out.insert( out.end(), m_groups.begin(), m_groups.end() );
+            client.connection.finishMessage( m_stats );
+            client.ackedEdit = client.appliedEdit;
+            m_stats.changesSent += changes;
+        }
+
+        detail::SocketHandle m_listener = detail::InvalidSocket;
+        int m_family = AF_INET;
+        std::string m_endpoint;
+        std::vector<std::unique_ptr<Client>> m_clients;
+        std::vector<std::uint8_t> m_groups;     // scratch, reused by every frame
+        std::vector<std::uint8_t> m_changes;
+        RemoteStats m_stats;
+    };
+
+    // Mirror of the objects of a RemoteServer<T>. Call everything from the GUI thread.
+    template<typename T>
+    class RemoteClient
+    {
+    public:
+        RemoteClient() = default;
+        RemoteClient( const RemoteClient& ) = delete;
+        RemoteClient& operator=( const RemoteClient& ) = delete;
+
+        bool connect( const std::string& endpoint, std::string* error = nullptr )
+        {
+            disconnect();
+            detail::RemoteAddress address;
+            if( !detail::initSockets() || !detail::parseEndpoint( endpoint, address, &m_error ) )
+            {
+                if( error )
+                    *error = m_error;
+                return false;
+            }
+            detail::SocketHandle s = socket( address.family, SOCK_STREAM, 0 );
+            if( s == detail::InvalidSocket || ::connect( s, reinterpret_cast< sockaddr* >(&address.storage), address.length ) != 0 )
+            {
+                if( s != detail::InvalidSocket )
+                    detail::closeSocket( s );
+                m_error = "Cannot connect to " + endpoint;
+                if( error )
+                    *error = m_error;
+                return false;
+            }
+            detail::configureSocket( s, address.family );
+            m_connection = std::make_unique<detail::RemoteConnection>( s );
+            m_error.clear();
+            return true;
+        }
+
+        void disconnect()
+        {
+            m_connection.reset();
+            m_ready = false;
+            m_pending.clear();
+        }
+
+        // True while connected (the objects may still be empty until the first frame).
+        bool connected() const { return m_connection && m_connection->open(); }
+        // True once the server's schema has been checked.
+        bool ready() const { return connected() && m_ready; }
+        const std::string& error() const { return m_error; }
+        const RemoteStats& stats() const { return m_stats; }
+
+        // Mirrored objects. Edits made to them are local until sent with sendEdits().
+        std::vector<T>& objects() { return m_objects; }
+
+        // Sends queued edits and applies the frames received since the last call. Returns the number of leaf values
+        // updated, or -1 once disconnected.
+        int poll()
+        {
+            if( !connected() )
+                return -1;
+            int updated = 0;
+            if( m_connection->receive( m_stats ) )
+            {
+                detail::RemoteMessage type;
+                const std::uint8_t* payload;
+                std::size_t size;
+                while( connected() && m_connection->nextMessage( type, payload, size ) )
+                {
+                    detail::RemoteReader in{ payload, size };
+                    if( type == detail::RemoteMessage::Hello )
+                        readHello( in );
+                    else if( type == detail::RemoteMessage::Frame && m_ready )
+                        updated += readFrame( in );
+                }
+            }
+            if( connected() )
+                m_connection->flush( m_stats );
+            if( !connected() && m_error.empty() )
+                m_error = "Disconnected";
+            return connected() ? updated : -1;
+        }
+
+        // Sends the leaves of objects()[ index ] listed in 'changes' (recorded by DrawImGui( obj, changes )).
+        void sendEdits( std::size_t index, const ChangeList& changes )
+        {
+            if( !ready() || index >= m_objects.size() || changes.empty() )
+                return;
+            const detail::RemoteLayout& layout = detail::getRemoteLayout<T>();
+            const std::uint64_t seq = ++m_lastEdit;
+            m_changes.clear();
+            std::uint32_t count = 0;
+            for( const FieldChange& change : changes.changes )
+            {
+                auto leafIt = layout.leafAtOffset.find( change.offset );
+                if( leafIt == layout.leafAtOffset.end() )
+                    continue;
+                const detail::RemoteLeaf& leaf = layout.leaves[ leafIt->second ];
+                const std::size_t slot = leaf.vector ? (change.elementIndex == FieldChange::npos ? 0 : change.elementIndex + 1) : 0;
+                detail::putVarint( m_changes, leafIt->second );
+                if( leaf.vector )
+                    detail::putVarint( m_changes, slot );
+                if( leaf.vector && slot == 0 )
+                    detail::putVarint( m_changes, leaf.field->element->size( reinterpret_cast< const char* >(&m_objects[ index ]) + leaf.offset ) );
+                else if( const void* value = detail::remoteSlot( &m_objects[ index ], leaf, slot ) )
+                    detail::putValue( m_changes, leaf.kind, value );
+                else
+                    continue;
+                m_pending.push_back( Pending{ index, leafIt->second, slot, seq } );
+                count++;
+            }
+            if( count == 0 )
+                return;
+            std::vector<std::uint8_t>& out = m_connection->beginMessage( detail::RemoteMessage::Edit );
+            detail::putVarint( out, seq );
+            detail::putVarint( out, 1 );
+            detail::putVarint( out, index );
+            detail::putVarint( out, count );
+            out.insert( out.end(), m_changes.begin(), m_changes.end() );
+            m_connection->finishMessage( m_stats );
+            m_stats.changesSent += count;
+            m_connection->flush( m_stats );
+        }
+
+    private:
+        // An edited leaf whose incoming values are ignored until the server has applied the edit.
+        struct Pending
+        {
+            std::size_t object;
+            std::uint32_t leaf;
+            std::size_t slot;
+            std::uint64_t seq;
+        };
+
+        void readHello( detail::RemoteReader& in )
+        {
+            const std::uint8_t* hash = in.bytes( 4 );
+            const std::uint64_t leafCount = in.varint();
+            const std::uint32_t schemaHash = hash ? ( std::uint32_t )hash[ 0 ] | (( std::uint32_t )hash[ 1 ] << 8) |
+                (( std::uint32_t )hash[ 2 ] << 16) | (( std::uint32_t )hash[ 3 ] << 24) : 0;
+            if( in.failed || schemaHash != getTypeMeta<T>().schemaHash || leafCount != detail::getRemoteLayout<T>().leaves.size() )
+            {
+                m_error = "The server's " + std::string( getTypeMeta<T>().name ) + " does not match this build";
+                m_connection->close();
+                return;
+            }
+            m_objects.clear();
+            m_ready = true;
+        }
+
+        int readFrame( detail::RemoteReader& in )
+        {
+            const std::uint64_t applied = in.varint();
+            const std::size_t count = ( std::size_t )in.varint();
+            if( in.failed || count > detail::RemoteMaxMessage )
+            {
+                m_connection->close();
+                return 0;
+            }
+            std::size_t done = 0;
+            while( done < m_pending.size() && m_pending[ done ].seq <= applied )
+                done++;
+            m_pending.erase( m_pending.begin(), m_pending.begin() + ( std::ptrdiff_t )done );
+            m_objects.resize( count );
+
+            int updated = 0;
+            const bool ok = detail::readGroups( in, detail::getRemoteLayout<T>(),
+                [&]( const detail::RemoteChange& change ) -> void*
+                {
+                    if( change.object >= m_objects.size() )
+                        return nullptr;
+                    for( const Pending& pending : m_pending )
+                        if( pending.object == change.object && pending.leaf == change.leaf && pending.slot == change.slot )
+                            return nullptr;         // sent before our edit was applied
+                    return &m_objects[ change.object ];
+                },
+                [&]( const detail::RemoteChange& ) { updated++; } );
+            m_stats.changesReceived += ( std::uint64_t )updated;
+            if( !ok )
+                m_connection->close();
+            return updated;
+        }
+
+        std::unique_ptr<detail::RemoteConnection> m_connection;
+        std::vector<T> m_objects;
+        std::vector<Pending> m_pending;     // ascending seq
+        std::vector<std::uint8_t> m_changes;
+        std::uint64_t m_lastEdit = 0;
+        bool m_ready = false;
+        std::string m_error;
+        RemoteStats m_stats;
+    };
+} // namespace ReflectiveJson
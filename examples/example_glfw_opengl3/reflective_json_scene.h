@@ -0,0 +1,655 @@
+// ReflectiveJson scene files: arrays of reflected structs in a binary container that is memory-mapped and read in
+// place. Opening a file only validates the header and matches its layout tables; records are decoded one at a time,
+// when they are touched.
+//
+// File layout (little-endian, everything 8-byte aligned):
+//   SceneFileHeader
+//   SceneTypeEntry[ typeCount ]     one per layout: the record type and the element types of its std::vector fields
+//   SceneFieldEntry[ fieldCount ]   per type, its leaves flattened: path ("owner/stats/strength"), kind, record offset
+//   names                           '\0'-terminated field paths and type names
+//   records[ recordCount ]          fixed-size records of type 0
+//   heap                            std::string characters and std::vector elements, referenced by (offset, count)
+//
+// Fields are matched by path and kind when a file is opened, so files stay readable after fields are added, removed
+// or reordered: unknown fields are ignored, missing ones keep the value of a default-constructed object.
+//
+// Usage:
+//   ReflectiveJson::writeScene( "players.scene", players.data(), players.size() );
+//   static ReflectiveJson::SceneView<Player> scene;
+//   scene.open( "players.scene" );
+//   Player& p = scene.at( 123456 );       // decoded now, cached afterwards
+//   ReflectiveJson::DrawImGui( p );
+
+#pragma once
+
+#include "reflective_json.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ReflectiveJson
+{
+    struct SceneFileHeader
+    {
+        char magic[ 8 ];                // "RJSCENE\0"
+        std::uint32_t version;
+        std::uint32_t typeCount;
+        std::uint32_t fieldCount;
+        std::uint32_t namesSize;
+        std::uint64_t recordCount;
+        std::uint64_t recordsOffset;
+        std::uint64_t heapOffset;
+        std::uint64_t heapSize;
+    };
+
+    struct SceneTypeEntry
+    {
+        std::uint32_t nameOffset;       // into names
+        std::uint32_t firstField;       // into the field entries
+        std::uint32_t fieldCount;
+        std::uint32_t recordSize;
+    };
+
+    struct SceneFieldEntry
+    {
+        std::uint32_t pathOffset;       // into names
+        std::uint32_t offset;           // in the record
+        std::uint8_t kind;              // FieldKind
+        std::uint8_t elementKind;       // FieldKind of the elements, for FieldKind::Vector
+        std::uint16_t reserved;
+        std::int32_t elementType;       // SceneTypeEntry index of reflected vector elements, -1 otherwise
+    };
+
+    // (offset into the heap, element or character count) of a std::string / std::vector field.
+    struct SceneHeapRef
+    {
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+
+    static constexpr char SceneMagic[ 8 ] = { 'R', 'J', 'S', 'C', 'E', 'N', 'E', 0 };
+    static constexpr std::uint32_t SceneVersion = 1;
+
+    namespace detail
+    {
+        // Size of a leaf in a record. Textures are widened to 64 bits; strings and vectors are heap references.
+        inline std::uint32_t sceneLeafSize( FieldKind kind )
+        {
+            switch( kind )
+            {
+            case FieldKind::Bool:       return 1;
+            case FieldKind::Int:        return 4;
+            case FieldKind::Float:      return 4;
+            case FieldKind::Vec2:       return 8;
+            case FieldKind::Vec4:       return 16;
+            case FieldKind::Texture:    return 8;
+            case FieldKind::String:
+            case FieldKind::Vector:     return sizeof( SceneHeapRef );
+            default:                    return 0;
+            }
+        }
+
+        inline std::uint32_t alignUp( std::uint32_t value, std::uint32_t alignment )
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // One leaf of a live type, with nested objects flattened.
+        struct FlatLeaf
+        {
+            std::string path;
+            std::size_t offset;             // from the start of the object
+            const FieldMeta* field;
+        };
+
+        inline void flattenLeaves( const TypeMeta& type, const std::string& prefix, std::size_t baseOffset, std::vector<FlatLeaf>& out )
+        {
+            for( const FieldMeta* field : type.fields )
+            {
+                std::string path = prefix.empty() ? std::string( field->name ) : prefix + "/" + field->name;
+                if( field->kind == FieldKind::Object && field->nested )
+                    flattenLeaves( *field->nested, path, baseOffset + field->offset, out );
+                else if( sceneLeafSize( field->kind ) != 0 )
+                    out.push_back( FlatLeaf{ std::move( path ), baseOffset + field->offset, field } );
+            }
+        }
+
+        // ---------- Writer ----------
+        class SceneWriter
+        {
+        public:
+            // Index of the layout for 'type', created (with the layouts of its vector element types) on first use.
+            int layoutFor( const TypeMeta& type )
+            {
+                for( std::size_t i = 0; i < m_layouts.size(); i++ )
+                    if( m_layouts[ i ].type == &type )
+                        return ( int )i;
+
+                const int index = ( int )m_layouts.size();
+                m_layouts.push_back( Layout{ &type, {}, {}, 0 } );
+                std::vector<FlatLeaf> leaves;
+                flattenLeaves( type, std::string(), 0, leaves );
+                std::uint32_t offset = 0;
+                std::vector<SceneFieldEntry> entries;
+                for( const FlatLeaf& leaf : leaves )
+                {
+                    const std::uint32_t size = sceneLeafSize( leaf.field->kind );
+                    offset = alignUp( offset, size >= 8 ? 8 : size );
+                    SceneFieldEntry entry{ addName( leaf.path ), offset, ( std::uint8_t )leaf.field->kind, 0, 0, -1 };
+                    if( leaf.field->kind == FieldKind::Vector )
+                    {
+                        const VectorMeta& element = *leaf.field->element;
+                        entry.elementKind = ( std::uint8_t )element.elementKind;
+                        if( element.elementKind == FieldKind::Object && element.elementNested )
+                            entry.elementType = layoutFor( *element.elementNested );
+                        else if( sceneLeafSize( element.elementKind ) == 0 || element.elementKind == FieldKind::Vector )
+                            entry.elementKind = ( std::uint8_t )FieldKind::Unsupported;
+                    }
+                    entries.push_back( entry );
+                    offset += size;
+                }
+                Layout& layout = m_layouts[ index ];
+                layout.leaves = std::move( leaves );
+                layout.entries = std::move( entries );
+                layout.recordSize = alignUp( offset, 8 );
+                return index;
+            }
+
+            void encode( int layoutIndex, const void* object, unsigned char* record )
+            {
+                const Layout& layout = m_layouts[ layoutIndex ];
+                std::memset( record, 0, layout.recordSize );
+                for( std::size_t i = 0; i < layout.leaves.size(); i++ )
+                {
+                    const FlatLeaf& leaf = layout.leaves[ i ];
+                    const SceneFieldEntry& entry = layout.entries[ i ];
+                    encodeLeaf( leaf.field->kind, leaf.field->element, entry, static_cast< const char* >(object) + leaf.offset, record + entry.offset );
+                }
+            }
+
+            // Layout 0 is the record type.
+            bool write( const std::string& path, const unsigned char* records, std::uint64_t recordCount, std::string* error )
+            {
+                std::vector<SceneTypeEntry> types;
+                std::vector<SceneFieldEntry> fields;
+                for( const Layout& layout : m_layouts )
+                {
+                    types.push_back( SceneTypeEntry{ addName( std::string( layout.type->name ) ), ( std::uint32_t )fields.size(),
+                        ( std::uint32_t )layout.entries.size(), layout.recordSize } );
+                    fields.insert( fields.end(), layout.entries.begin(), layout.entries.end() );
+                }
+                SceneFileHeader header{};
+                std::memcpy( header.magic, SceneMagic, sizeof( header.magic ) );
+                header.version = SceneVersion;
+                header.typeCount = ( std::uint32_t )types.size();
+                header.fieldCount = ( std::uint32_t )fields.size();
+                header.namesSize = ( std::uint32_t )m_names.size();
+                header.recordCount = recordCount;
+                header.recordsOffset = alignUp64( sizeof( header ) + types.size() * sizeof( SceneTypeEntry ) + fields.size() * sizeof( SceneFieldEntry ) + m_names.size() );
+                header.heapOffset = alignUp64( header.recordsOffset + recordCount * m_layouts[ 0 ].recordSize );
+                header.heapSize = m_heap.size();
+
+                std::ofstream file( path, std::ios::binary | std::ios::trunc );
+                if( !file )
+                {
+                    if( error )
+                        *error = "cannot open " + path + " for writing";
+                    return false;
+                }
+                static const char padding[ 8 ] = {};
+                file.write( reinterpret_cast< const char* >(&header), sizeof( header ) );
+                file.write( reinterpret_cast< const char* >(types.data()), ( std::streamsize )(types.size() * sizeof( SceneTypeEntry )) );
+                file.write( reinterpret_cast< const char* >(fields.data()), ( std::streamsize )(fields.size() * sizeof( SceneFieldEntry )) );
+                file.write( m_names.data(), ( std::streamsize )m_names.size() );
+                file.write( padding, ( std::streamsize )(header.recordsOffset - ( std::uint64_t )file.tellp()) );
+                file.write( reinterpret_cast< const char* >(records), ( std::streamsize )(recordCount * m_layouts[ 0 ].recordSize) );
+                file.write( padding, ( std::streamsize )(header.heapOffset - ( std::uint64_t )file.tellp()) );
+                file.write( reinterpret_cast< const char* >(m_heap.data()), ( std::streamsize )m_heap.size() );
+                if( !file && error )
+                    *error = "write error on " + path;
+                return ( bool )file;
+            }
+
+            std::uint32_t recordSize( int layoutIndex ) const { return m_layouts[ layoutIndex ].recordSize; }
+
+        private:
+            struct Layout
+            {
+                const TypeMeta* type;
+                std::vector<FlatLeaf> leaves;
+                std::vector<SceneFieldEntry> entries;
+                std::uint32_t recordSize;
+            };
+
+            static std::uint64_t alignUp64( std::uint64_t value ) { return (value + 7) & ~( std::uint64_t )7; }
+
+            std::uint32_t addName( const std::string& name )
+            {
+                const std::uint32_t offset = ( std::uint32_t )m_names.size();
+                m_names.insert( m_names.end(), name.begin(), name.end() );
+                m_names.push_back( '\0' );
+                return offset;
+            }
+
+            SceneHeapRef appendHeap( const void* data, std::size_t size, std::uint64_t count )
+            {
+                const SceneHeapRef ref{ alignUp64( m_heap.size() ), count };
+                m_heap.resize( ( std::size_t )ref.offset + size );
+                if( size )
+                    std::memcpy( m_heap.data() + ref.offset, data, size );
+                return ref;
+            }
+
+            static void encodeScalar( FieldKind kind, const void* value, unsigned char* out )
+            {
+                if( kind == FieldKind::Texture )
+                {
+                    const std::uint64_t id = ( std::uint64_t )*static_cast< const ImTextureID* >(value);
+                    std::memcpy( out, &id, sizeof( id ) );
+                }
+                else
+                {
+                    std::memcpy( out, value, sceneLeafSize( kind ) );
+                }
+            }
+
+            void encodeLeaf( FieldKind kind, const VectorMeta* element, const SceneFieldEntry& entry, const void* value, unsigned char* out )
+            {
+                SceneHeapRef ref{};
+                if( kind == FieldKind::String )
+                {
+                    const std::string& str = *static_cast< const std::string* >(value);
+                    ref = appendHeap( str.data(), str.size(), str.size() );
+                }
+                else if( kind == FieldKind::Vector )
+                {
+                    const FieldKind elementKind = ( FieldKind )entry.elementKind;
+                    const std::size_t count = element->size( value );
+                    const std::uint32_t stride = entry.elementType >= 0 ? m_layouts[ entry.elementType ].recordSize : sceneLeafSize( elementKind );
+                    if( elementKind == FieldKind::Unsupported || stride == 0 )
+                    {
+                        std::memcpy( out, &ref, sizeof( ref ) );
+                        return;
+                    }
+                    // Elements are encoded first: they may append their own strings/vectors to the heap.
+                    std::vector<unsigned char> elements( count * stride );
+                    for( std::size_t i = 0; i < count; i++ )
+                    {
+                        const void* item = element->at_const( value, i );
+                        unsigned char* dst = elements.data() + i * stride;
+                        if( entry.elementType >= 0 )
+                            encode( entry.elementType, item, dst );
+                        else if( elementKind == FieldKind::String )
+                            encodeLeaf( elementKind, nullptr, entry, item, dst );
+                        else
+                            encodeScalar( elementKind, item, dst );
+                    }
+                    ref = appendHeap( elements.data(), elements.size(), count );
+                }
+                else
+                {
+                    encodeScalar( kind, value, out );
+                    return;
+                }
+                std::memcpy( out, &ref, sizeof( ref ) );
+            }
+
+            std::vector<Layout> m_layouts;
+            std::vector<char> m_names;
+            std::vector<unsigned char> m_heap;
+        };
+    } // namespace detail
+
+    // Writes objects[ 0 .. count ) to a scene file.
+    template<typename T>
+    bool writeScene( const std::string& path, const T* objects, std::size_t count, std::string* error = nullptr )
+    {
+        detail::SceneWriter writer;
+        const int root = writer.layoutFor( getTypeMeta<T>() );
+        const std::size_t recordSize = writer.recordSize( root );
+        std::vector<unsigned char> records( count * recordSize );
+        for( std::size_t i = 0; i < count; i++ )
+            writer.encode( root, &objects[ i ], records.data() + i * recordSize );
+        return writer.write( path, records.data(), count, error );
+    }
+
+    // ---------- Reader ----------
+    // Read-only memory mapping of a whole file.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile( const MappedFile& ) = delete;
+        MappedFile& operator=( const MappedFile& ) = delete;
+        ~MappedFile() { close(); }
+
+        bool open( const std::string& path )
+        {
+            close();
+#ifdef _WIN32
+            HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+            if( file == INVALID_HANDLE_VALUE )
+                return false;
+            LARGE_INTEGER size;
+            if( GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+            {
+                HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+                if( mapping )
+                {
+                    m_data = static_cast< const unsigned char* >(MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ));
+                    CloseHandle( mapping );
+                }
+                m_size = m_data ? ( std::size_t )size.QuadPart : 0;
+            }
+            CloseHandle( file );
+#else
+            const int fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+            if( fd < 0 )
+                return false;
+            struct stat st;
+            if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+            {
+                void* data = mmap( nullptr, ( std::size_t )st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+                if( data != MAP_FAILED )
+                {
+                    m_data = static_cast< const unsigned char* >(data);
+                    m_size = ( std::size_t )st.st_size;
+                }
+            }
+            ::close( fd );
+#endif
+            return m_data != nullptr;
+        }
+
+        void close()
+        {
+            if( !m_data )
+                return;
+#ifdef _WIN32
+            UnmapViewOfFile( m_data );
+#else
+            munmap( const_cast< unsigned char* >(m_data), m_size );
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        const unsigned char* data() const   { return m_data; }
+        std::size_t size() const            { return m_size; }
+
+    private:
+        const unsigned char* m_data = nullptr;
+        std::size_t m_size = 0;
+    };
+
+    namespace detail
+    {
+        // How the leaves of one file type map onto a live type.
+        struct SceneLayout
+        {
+            struct Leaf
+            {
+                std::uint32_t fileOffset;
+                std::size_t liveOffset;
+                const FieldMeta* field;         // live leaf (vector fields carry the VectorMeta)
+                FieldKind elementKind;
+                int elementLayout;              // index into SceneReader::m_layouts, reflected vector elements
+            };
+            std::uint32_t recordSize = 0;
+            std::vector<Leaf> leaves;
+        };
+
+        class SceneReader
+        {
+        public:
+            bool open( const std::string& path, const TypeMeta& type, std::string* error )
+            {
+                m_layouts.clear();
+                if( !m_file.open( path ) )
+                    return fail( error, "cannot map " + path );
+                if( m_file.size() < sizeof( SceneFileHeader ) )
+                    return fail( error, path + " is too small" );
+                std::memcpy( &m_header, m_file.data(), sizeof( m_header ) );
+                if( std::memcmp( m_header.magic, SceneMagic, sizeof( SceneMagic ) ) != 0 || m_header.version != SceneVersion )
+                    return fail( error, path + " is not a version 1 scene file" );
+
+                const std::uint64_t tablesEnd = sizeof( SceneFileHeader ) + ( std::uint64_t )m_header.typeCount * sizeof( SceneTypeEntry ) +
+                    ( std::uint64_t )m_header.fieldCount * sizeof( SceneFieldEntry ) + m_header.namesSize;
+                // Tables <= records <= heap <= end of file, compared without sums or products that could wrap.
+                const std::uint64_t fileSize = m_file.size();
+                if( m_header.typeCount == 0 || m_header.namesSize == 0 || tablesEnd > m_header.recordsOffset ||
+                    m_header.recordsOffset > m_header.heapOffset || m_header.heapOffset > fileSize || m_header.heapSize > fileSize - m_header.heapOffset )
+                    return fail( error, path + " has an invalid header" );
+                m_types = reinterpret_cast< const SceneTypeEntry* >(m_file.data() + sizeof( SceneFileHeader ));
+                m_fields = reinterpret_cast< const SceneFieldEntry* >(m_types + m_header.typeCount);
+                m_names = reinterpret_cast< const char* >(m_fields + m_header.fieldCount);
+                const std::uint32_t rootRecordSize = m_types[ 0 ].recordSize;
+                if( rootRecordSize != 0 && m_header.recordCount > (m_header.heapOffset - m_header.recordsOffset) / rootRecordSize )
+                    return fail( error, path + " has an invalid header" );
+                if( m_names[ m_header.namesSize - 1 ] != '\0' )
+                    return fail( error, path + " has an unterminated names table" );     // name() returns C strings into it
+
+                m_typeMap.assign( m_header.typeCount, -1 );
+                m_root = matchLayout( 0, type );
+                return m_root >= 0 ? true : fail( error, path + " has invalid layout tables" );
+            }
+
+            std::uint64_t recordCount() const { return m_header.recordCount; }
+
+            void decode( std::uint64_t index, void* object ) const
+            {
+                const unsigned char* record = m_file.data() + m_header.recordsOffset + index * m_layouts[ m_root ].recordSize;
+                decodeRecord( m_root, record, object );
+            }
+
+        private:
+            static bool fail( std::string* error, const std::string& message )
+            {
+                if( error )
+                    *error = message;
+                return false;
+            }
+
+            const char* name( std::uint32_t offset ) const
+            {
+                return offset < m_header.namesSize ? m_names + offset : "";
+            }
+
+            // Builds (once per file type) the mapping of file type 'typeIndex' onto the live 'type'. -1 if corrupt.
+            int matchLayout( std::uint32_t typeIndex, const TypeMeta& type )
+            {
+                if( typeIndex >= m_header.typeCount )
+                    return -1;
+                if( m_typeMap[ typeIndex ] >= 0 )
+                    return m_typeMap[ typeIndex ];
+                const SceneTypeEntry& entry = m_types[ typeIndex ];
+                if( ( std::uint64_t )entry.firstField + entry.fieldCount > m_header.fieldCount )
+                    return -1;
+
+                const int index = ( int )m_layouts.size();
+                m_typeMap[ typeIndex ] = index;
+                m_layouts.emplace_back();
+                m_layouts[ index ].recordSize = entry.recordSize;
+
+                std::vector<FlatLeaf> live;
+                flattenLeaves( type, std::string(), 0, live );
+                for( std::uint32_t f = 0; f < entry.fieldCount; f++ )
+                {
+                    const SceneFieldEntry& field = m_fields[ entry.firstField + f ];
+                    const FieldKind kind = ( FieldKind )field.kind;
+                    if( field.offset + sceneLeafSize( kind ) > entry.recordSize )
+                        return -1;
+                    const char* path = name( field.pathOffset );
+                    for( const FlatLeaf& leaf : live )
+                    {
+                        if( leaf.field->kind != kind || leaf.path != path )
+                            continue;
+                        SceneLayout::Leaf mapped{ field.offset, leaf.offset, leaf.field, ( FieldKind )field.elementKind, -1 };
+                        if( kind == FieldKind::Vector )
+                        {
+                            const VectorMeta& element = *leaf.field->element;
+                            if( element.elementKind != mapped.elementKind )
+                                break;
+                            if( field.elementType >= 0 )
+                            {
+                                if( !element.elementNested )
+                                    break;
+                                mapped.elementLayout = matchLayout( ( std::uint32_t )field.elementType, *element.elementNested );
+                                if( mapped.elementLayout < 0 )
+                                    return -1;
+                            }
+                        }
+                        m_layouts[ index ].leaves.push_back( mapped );
+                        break;
+                    }
+                }
+                return index;
+            }
+
+            bool heapRange( const SceneHeapRef& ref, std::uint64_t stride, const unsigned char*& data ) const
+            {
+                if( ref.offset > m_header.heapSize || (stride && ref.count > (m_header.heapSize - ref.offset) / stride) )
+                    return false;
+                data = m_file.data() + m_header.heapOffset + ref.offset;
+                return true;
+            }
+
+            static void decodeScalar( FieldKind kind, const unsigned char* in, void* value )
+            {
+                if( kind == FieldKind::Texture )
+                {
+                    std::uint64_t id;
+                    std::memcpy( &id, in, sizeof( id ) );
+                    *static_cast< ImTextureID* >(value) = ( ImTextureID )id;
+                }
+                else
+                {
+                    std::memcpy( value, in, sceneLeafSize( kind ) );
+                }
+            }
+
+            void decodeString( const unsigned char* in, std::string& value ) const
+            {
+                SceneHeapRef ref;
+                std::memcpy( &ref, in, sizeof( ref ) );
+                const unsigned char* data;
+                if( heapRange( ref, 1, data ) )
+                    value.assign( reinterpret_cast< const char* >(data), ( std::size_t )ref.count );
+            }
+
+            void decodeRecord( int layoutIndex, const unsigned char* record, void* object ) const
+            {
+                const SceneLayout& layout = m_layouts[ layoutIndex ];
+                for( const SceneLayout::Leaf& leaf : layout.leaves )
+                {
+                    const unsigned char* in = record + leaf.fileOffset;
+                    void* value = static_cast< char* >(object) + leaf.liveOffset;
+                    switch( leaf.field->kind )
+                    {
+                    case FieldKind::String:
+                        decodeString( in, *static_cast< std::string* >(value) );
+                        break;
+                    case FieldKind::Vector:
+                        decodeVector( leaf, in, value );
+                        break;
+                    default:
+                        decodeScalar( leaf.field->kind, in, value );
+                        break;
+                    }
+                }
+            }
+
+            void decodeVector( const SceneLayout::Leaf& leaf, const unsigned char* in, void* value ) const
+            {
+                SceneHeapRef ref;
+                std::memcpy( &ref, in, sizeof( ref ) );
+                const std::uint32_t stride = leaf.elementLayout >= 0 ? m_layouts[ leaf.elementLayout ].recordSize : sceneLeafSize( leaf.elementKind );
+                const unsigned char* data;
+                if( stride == 0 || !heapRange( ref, stride, data ) )
+                    return;
+                const VectorMeta& element = *leaf.field->element;
+                element.resize( value, ( std::size_t )ref.count );
+                for( std::size_t i = 0; i < ( std::size_t )ref.count; i++ )
+                {
+                    void* item = element.at( value, i );
+                    const unsigned char* src = data + i * stride;
+                    if( leaf.elementLayout >= 0 )
+                        decodeRecord( leaf.elementLayout, src, item );
+                    else if( leaf.elementKind == FieldKind::String )
+                        decodeString( src, *static_cast< std::string* >(item) );
+                    else
+                        decodeScalar( leaf.elementKind, src, item );
+                }
+            }
+
+            MappedFile m_file;
+            SceneFileHeader m_header{};
+            const SceneTypeEntry* m_types = nullptr;
+            const SceneFieldEntry* m_fields = nullptr;
+            const char* m_names = nullptr;
+            std::vector<int> m_typeMap;             // file type index -> m_layouts index
+            std::vector<SceneLayout> m_layouts;
+            int m_root = -1;
+        };
+    } // namespace detail
+
+    // Lazily decoded view of a scene file of T records.
+    template<typename T>
+    class SceneView
+    {
+    public:
+        bool open( const std::string& path, std::string* error = nullptr )
+        {
+            m_cache.clear();
+            m_open = m_reader.open( path, getTypeMeta<T>(), error );
+            return m_open;
+        }
+
+        bool isOpen() const { return m_open; }
+        std::size_t size() const { return m_open ? ( std::size_t )m_reader.recordCount() : 0; }
+
+        // Decodes record 'index' into 'out' (fields missing from the file keep their value in 'out').
+        void decode( std::size_t index, T& out ) const
+        {
+            IM_ASSERT( index < size() );
+            m_reader.decode( index, &out );
+        }
+
+        // Record 'index', decoded on first access. The reference stays valid until open() or clearCache().
+        T& at( std::size_t index )
+        {
+            std::unique_ptr<T>& slot = m_cache[ index ];
+            if( !slot )
+            {
+                slot = std::make_unique<T>();
+                decode( index, *slot );
+            }
+            return *slot;
+        }
+
+        std::size_t decodedCount() const { return m_cache.size(); }
+        void clearCache() { m_cache.clear(); }
+
+    private:
+        detail::SceneReader m_reader;
+        std::unordered_map<std::size_t, std::unique_ptr<T>> m_cache;
+        bool m_open = false;
+    };
+} // namespace ReflectiveJson
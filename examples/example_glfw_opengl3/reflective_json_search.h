@@ -0,0 +1,177 @@
+// ReflectiveJson field search: find fields by path ("owner.stats.agility") across many objects of one reflected type.
+//
+// Every type gets a flat list of its field paths, built once from the nested getFields() tables (getFieldPathIndex<T>()).
+// Typing in the search box filters that list only, a few dozen strings with the ImGuiTextFilter syntax
+// ("stats,-agility"); the objects are not walked. The results (matching paths x objects) are listed through
+// ImGuiListClipper, so only the visible rows read their object. Clicking a result calls revealField(): the next
+// DrawImGui() of that object opens the headers down to the field and scrolls to it.
+//
+// Usage:
+//   static ReflectiveJson::FieldSearch search;
+//   ReflectiveJson::DrawFieldSearch( "##search", materials.data(), materials.size(), search );
+//   for( Material& material : materials )
+//       ReflectiveJson::DrawImGui( material );
+
+#pragma once
+
+#include "reflective_json.h"
+
+namespace ReflectiveJson
+{
+    struct FieldPath
+    {
+        std::string path;                   // "owner.stats.agility"
+        const FieldMeta* field = nullptr;   // last member of the path
+        std::size_t offset = 0;             // of that member from the start of the root object
+    };
+
+    // Every field of a type, nested ones included, depth first in declaration order.
+    struct FieldPathIndex
+    {
+        const TypeMeta* type = nullptr;
+        std::vector<FieldPath> paths;
+    };
+
+    namespace detail
+    {
+        inline void appendFieldPaths( const TypeMeta& type, std::string& prefix, std::size_t offset, std::vector<FieldPath>& out )
+        {
+            const std::size_t prefixLength = prefix.size();
+            for( const FieldMeta* field : type.fields )
+            {
+                if( prefixLength > 0 )
+                    prefix += '.';
+                prefix += field->name;
+                out.push_back( FieldPath{ prefix, field, offset + field->offset } );
+                if( field->kind == FieldKind::Object && field->nested )
+                    appendFieldPaths( *field->nested, prefix, offset + field->offset, out );
+                prefix.resize( prefixLength );
+            }
+        }
+    } // namespace detail
+
+    inline FieldPathIndex buildFieldPathIndex( const TypeMeta& type )
+    {
+        FieldPathIndex index;
+        index.type = &type;
+        std::string prefix;
+        detail::appendFieldPaths( type, prefix, 0, index.paths );
+        return index;
+    }
+
+    template<typename T>
+    const FieldPathIndex& getFieldPathIndex()
+    {
+        static const FieldPathIndex index = buildFieldPathIndex( getTypeMeta<T>() );
+        return index;
+    }
+
+    // Short text of a field value for result lists, written to 'buf' (no allocation).
+    inline void formatFieldValue( char* buf, std::size_t size, const FieldMeta& field, const void* value )
+    {
+        switch( field.kind )
+        {
+        case FieldKind::Bool:       ImFormatString( buf, size, "%s", *static_cast< const bool* >(value) ? "true" : "false" ); break;
+        case FieldKind::Int:        ImFormatString( buf, size, "%d", *static_cast< const int* >(value) ); break;
+        case FieldKind::Float:      ImFormatString( buf, size, "%.3f", *static_cast< const float* >(value) ); break;
+        case FieldKind::String:
+        {
+            const std::string& text = *static_cast< const std::string* >(value);
+            ImFormatString( buf, size, "\"%.*s\"", ( int )ImMin( text.size(), ( std::size_t )64 ), text.data() );
+            break;
+        }
+        case FieldKind::Vec2:
+        {
+            const ImVec2& v = *static_cast< const ImVec2* >(value);
+            ImFormatString( buf, size, "(%.3f, %.3f)", v.x, v.y );
+            break;
+        }
+        case FieldKind::Vec4:
+        {
+            const ImVec4& v = *static_cast< const ImVec4* >(value);
+            ImFormatString( buf, size, "(%.3f, %.3f, %.3f, %.3f)", v.x, v.y, v.z, v.w );
+            break;
+        }
+        case FieldKind::Vector:     ImFormatString( buf, size, "[%d items]", ( int )field.element->size( value ) ); break;
+        case FieldKind::Object:     ImFormatString( buf, size, "{...}" ); break;
+        default:                    ImFormatString( buf, size, "%.*s", ( int )field.typeName.size(), field.typeName.data() ); break;
+        }
+    }
+
+    // Search box state: the filter text and the paths it matches in the index it was last applied to.
+    struct FieldSearch
+    {
+        ImGuiTextFilter filter;
+        const FieldPathIndex* index = nullptr;
+        std::vector<int> matches;           // into index->paths
+        int resultRows = 10;                // height of the results list
+
+        // Re-filters the index: O(paths), independent of the object count.
+        void apply( const FieldPathIndex& pathIndex )
+        {
+            index = &pathIndex;
+            matches.clear();
+            if( !filter.IsActive() )
+                return;
+            for( int i = 0; i < ( int )pathIndex.paths.size(); i++ )
+            {
+                const std::string& path = pathIndex.paths[ i ].path;
+                if( filter.PassFilter( path.data(), path.data() + path.size() ) )
+                    matches.push_back( i );
+            }
+        }
+    };
+
+    // Search box and result list over objects[ 0 .. count ). One row per (object, matching path), object by object.
+    // Returns true when a result was clicked (the field is then revealed in the object's DrawImGui()).
+    template<typename T>
+    bool DrawFieldSearch( const char* label, T* objects, std::size_t count, FieldSearch& search )
+    {
+        static_assert( has_getFields_v<T>, "DrawFieldSearch needs a reflected type" );
+        const FieldPathIndex& index = getFieldPathIndex<T>();
+        ImGui::PushID( label );
+        if( search.filter.Draw( label, -FLT_MIN ) || search.index != &index )
+            search.apply( index );
+        bool clicked = false;
+        if( !search.filter.IsActive() )
+        {
+            ImGui::PopID();
+            return clicked;
+        }
+
+        const std::size_t perObject = search.matches.size();
+        const std::size_t total = perObject * count;
+        ImGui::TextDisabled( "%d of %d fields, %zu results", ( int )perObject, ( int )index.paths.size(), total );
+        const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+        const int visibleRows = ImClamp( ( int )ImMin( total, ( std::size_t )INT_MAX ), 1, search.resultRows );
+        if( total > 0 && ImGui::BeginChild( "##results", ImVec2( 0.0f, rowHeight * visibleRows + ImGui::GetStyle().WindowPadding.y * 2.0f ), ImGuiChildFlags_Borders ) )
+        {
+            char text[ 256 ];
+            char value[ 96 ];
+            ImGuiListClipper clipper;
+            clipper.Begin( ( int )ImMin( total, ( std::size_t )INT_MAX ), rowHeight );
+            while( clipper.Step() )
+            {
+                for( int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++ )
+                {
+                    const std::size_t objectIndex = ( std::size_t )row / perObject;
+                    const FieldPath& path = index.paths[ search.matches[ ( std::size_t )row % perObject ] ];
+                    const char* member = reinterpret_cast< const char* >(&objects[ objectIndex ]) + path.offset;
+                    formatFieldValue( value, sizeof( value ), *path.field, member );
+                    ImFormatString( text, sizeof( text ), "[%zu] %s = %s", objectIndex, path.path.c_str(), value );
+                    ImGui::PushID( row );
+                    if( ImGui::Selectable( text ) )
+                    {
+                        revealField( member, *path.field );
+                        clicked = true;
+                    }
+                    ImGui::PopID();
+                }
+            }
+        }
+        if( total > 0 )
+            ImGui::EndChild();
+        ImGui::PopID();
+        return clicked;
+    }
+} // namespace ReflectiveJson
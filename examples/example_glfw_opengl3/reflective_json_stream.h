@@ -0,0 +1,483 @@
+// ReflectiveJson streaming serializer: writes reflected structs as native JSON straight to an nlohmann output adapter.
+//
+// Unlike toJson(), no nlohmann::json DOM is built and no value goes through a std::string:
+// - int/unsigned  -> JSON integer (std::to_chars)
+// - float/double  -> JSON number (nlohmann::detail::to_chars, shortest round-trip form; NaN/Inf -> null)
+// - bool          -> true/false
+// - std::string   -> escaped JSON string
+// - ImVec2/ImVec4 -> [x, y] / [x, y, z, w]
+// - ImTextureID   -> JSON integer
+// - std::vector<E> -> JSON array of E
+// - E[ N ]        -> JSON array of N numbers/booleans (E arithmetic)
+// - reflected T   -> nested JSON object, recursively
+//
+// Usage:
+//   std::string text;
+//   ReflectiveJson::dumpJson( material, text );        // also accepts std::vector<char>& and std::ostream&
+//   ReflectiveJson::dumpJson( material, std::cout, 4 ); // pretty-printed
+//
+// fromJson() reads the same format back with nlohmann's SAX parser, storing values directly into the members
+// found through getFields(). No DOM is built; unknown keys and mismatched values are skipped, missing keys keep
+// their current value, and RTTI_FIELD_WITH_RANGE ranges are enforced by clamping. A std::vector field present in
+// the input is replaced by the array's elements; ImVec2/ImVec4 and C array fields are filled element by element
+// (extra elements are ignored, null or mismatched ones keep their value).
+
+#pragma once
+
+#include "reflective_json.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace ReflectiveJson
+{
+    using JsonOutput = nlohmann::detail::output_adapter_t<char>;
+
+    class JsonWriter
+    {
+    public:
+        explicit JsonWriter( JsonOutput out, int indent = -1 )
+            : m_out( std::move( out ) ), m_indent( indent ) {}
+
+        template<typename T>
+        void writeObject( const T& obj )
+        {
+            m_out->write_character( '{' );
+            m_depth++;
+            bool first = true;
+            forEachField<T>( [&]( const auto& desc )
+            {
+                if( !first )
+                    m_out->write_character( ',' );
+                first = false;
+                newLine();
+                writeString( desc.name );
+                m_out->write_character( ':' );
+                if( m_indent >= 0 )
+                    m_out->write_character( ' ' );
+                writeValue( obj.*desc.member );
+            } );
+            m_depth--;
+            if( !first )
+                newLine();
+            m_out->write_character( '}' );
+        }
+
+        template<typename M>
+        void writeValue( const M& value )
+        {
+            if constexpr( has_getFields_v<M> )
+                writeObject( value );
+            else if constexpr( std::is_same_v<M, bool> )
+                value ? writeRaw( "true", 4 ) : writeRaw( "false", 5 );
+            else if constexpr( std::is_integral_v<M> )
+                writeInteger( value );
+            else if constexpr( std::is_floating_point_v<M> )
+                writeFloat( value );
+            else if constexpr( std::is_same_v<M, std::string> )
+                writeString( value );
+            else if constexpr( std::is_same_v<M, ImVec2> )
+                writeFloatArray( &value.x, 2 );
+            else if constexpr( std::is_same_v<M, ImVec4> )
+                writeFloatArray( &value.x, 4 );
+            else if constexpr( is_std_vector_v<M> )
+                writeArray( value );
+            else if constexpr( std::rank_v<M> == 1 && std::is_arithmetic_v<std::remove_extent_t<M>> )
+            {
+                m_out->write_character( '[' );
+                for( std::size_t i = 0; i < std::extent_v<M>; i++ )
+                {
+                    if( i > 0 )
+                        m_out->write_character( ',' );
+                    writeValue( value[ i ] );
+                }
+                m_out->write_character( ']' );
+            }
+            else if constexpr( std::is_pointer_v<M> )
+                writeInteger( reinterpret_cast< uintptr_t >(value) );
+            else
+                writeRaw( "null", 4 );
+        }
+
+        void writeString( std::string_view str )
+        {
+            static const char hex[] = "0123456789abcdef";
+            m_out->write_character( '"' );
+            std::size_t runStart = 0;
+            for( std::size_t i = 0; i < str.size(); i++ )
+            {
+                const unsigned char c = ( unsigned char )str[ i ];
+                if( c >= 0x20 && c != '"' && c != '\\' )
+                    continue;
+
+                // Flush the run of characters that need no escaping, then the escape sequence.
+                m_out->write_characters( str.data() + runStart, i - runStart );
+                runStart = i + 1;
+                char escape[ 6 ] = { '\\', 0, 0, 0, 0, 0 };
+                std::size_t escapeLen = 2;
+                switch( c )
+                {
+                case '"':  escape[ 1 ] = '"'; break;
+                case '\\': escape[ 1 ] = '\\'; break;
+                case '\b': escape[ 1 ] = 'b'; break;
+                case '\f': escape[ 1 ] = 'f'; break;
+                case '\n': escape[ 1 ] = 'n'; break;
+                case '\r': escape[ 1 ] = 'r'; break;
+                case '\t': escape[ 1 ] = 't'; break;
+                default:
+                    escape[ 1 ] = 'u'; escape[ 2 ] = '0'; escape[ 3 ] = '0';
+                    escape[ 4 ] = hex[ c >> 4 ]; escape[ 5 ] = hex[ c & 0xF ];
+                    escapeLen = 6;
+                    break;
+                }
+                m_out->write_characters( escape, escapeLen );
+            }
+            m_out->write_characters( str.data() + runStart, str.size() - runStart );
+            m_out->write_character( '"' );
+        }
+
+        template<typename I>
+        void writeInteger( I value )
+        {
+            char buffer[ 24 ];
+            const std::to_chars_result result = std::to_chars( buffer, buffer + sizeof( buffer ), value );
+            m_out->write_characters( buffer, ( std::size_t )(result.ptr - buffer) );
+        }
+
+        template<typename F>
+        void writeFloat( F value )
+        {
+            if( !std::isfinite( value ) )
+            {
+                writeRaw( "null", 4 );
+                return;
+            }
+            char buffer[ 64 ];
+            char* end = nlohmann::detail::to_chars( buffer, buffer + sizeof( buffer ), value );
+            m_out->write_characters( buffer, ( std::size_t )(end - buffer) );
+        }
+
+        template<typename E>
+        void writeArray( const std::vector<E>& values )
+        {
+            m_out->write_character( '[' );
+            for( std::size_t i = 0; i < values.size(); i++ )
+            {
+                if( i > 0 )
+                    m_out->write_character( ',' );
+                writeValue( values[ i ] );
+            }
+            m_out->write_character( ']' );
+        }
+
+    private:
+        void writeRaw( const char* str, std::size_t length )
+        {
+            m_out->write_characters( str, length );
+        }
+
+        void writeFloatArray( const float* values, int count )
+        {
+            m_out->write_character( '[' );
+            for( int i = 0; i < count; i++ )
+            {
+                if( i > 0 )
+                    m_out->write_character( ',' );
+                writeFloat( values[ i ] );
+            }
+            m_out->write_character( ']' );
+        }
+
+        void newLine()
+        {
+            if( m_indent < 0 )
+                return;
+            m_out->write_character( '\n' );
+            for( int i = 0; i < m_depth * m_indent; i++ )
+                m_out->write_character( ' ' );
+        }
+
+        JsonOutput m_out;
+        int m_indent;
+        int m_depth = 0;
+    };
+
+    // Writes obj as a JSON object to a std::string&, std::vector<char>& or std::ostream&.
+    // indent < 0 writes compact JSON, indent >= 0 pretty-prints with that many spaces per level (like json::dump()).
+    template<typename T>
+    void dumpJson( const T& obj, nlohmann::detail::output_adapter<char> out, int indent = -1 )
+    {
+        JsonWriter writer( out, indent );
+        writer.writeObject( obj );
+    }
+
+    template<typename T>
+    std::string dumpJson( const T& obj, int indent = -1 )
+    {
+        std::string result;
+        dumpJson( obj, result, indent );
+        return result;
+    }
+
+    // ---------- SAX reader ----------
+    // The stack holds one frame per open container that is being loaded: reflected objects (type != nullptr) and
+    // std::vector fields (vector != nullptr), whose elements are appended as they are parsed.
+    class JsonReader : public nlohmann::json_sax<json>
+    {
+    public:
+        JsonReader( void* root, const TypeMeta& rootType )
+            : m_root( root ), m_rootType( rootType ) {}
+
+        const std::string& error() const { return m_error; }
+
+        bool null() override                                    { return m_array ? skipArrayElement() : skipValue(); }
+        bool boolean( bool value ) override                     { return storeBool( value ); }
+        bool number_integer( number_integer_t value ) override  { return storeNumber( ( double )value, true, ( ImTextureID )value ); }
+        bool number_unsigned( number_unsigned_t value ) override { return storeNumber( ( double )value, true, ( ImTextureID )value ); }
+        bool number_float( number_float_t value, const string_t& ) override { return storeNumber( value, false, ImTextureID() ); }
+        bool string( string_t& value ) override                 { return storeString( value ); }
+        bool binary( binary_t& ) override                       { return m_array ? skipArrayElement() : skipValue(); }
+
+        bool start_object( std::size_t ) override
+        {
+            if( m_skipDepth == 0 && m_array )
+                skipArrayElement();
+            if( m_skipDepth > 0 || m_array )
+                return skipContainer();
+            if( m_stack.empty() && !m_started )
+            {
+                m_started = true;
+                m_stack.push_back( Frame{ m_root, &m_rootType, nullptr } );
+                return true;
+            }
+            const Slot slot = takeSlot();
+            if( slot.kind == FieldKind::Object && slot.nested )
+            {
+                m_stack.push_back( Frame{ slotPtr( slot ), slot.nested, nullptr } );
+                return true;
+            }
+            return skipContainer();
+        }
+
+        bool key( string_t& name ) override
+        {
+            if( m_skipDepth == 0 )
+                m_pending = m_stack.back().type->findField( name );
+            return true;
+        }
+
+        bool end_object() override
+        {
+            if( m_skipDepth > 0 )
+                m_skipDepth--;
+            else
+                m_stack.pop_back();
+            return true;
+        }
+
+        bool start_array( std::size_t ) override
+        {
+            if( m_skipDepth == 0 && m_array )
+                skipArrayElement();
+            if( m_skipDepth > 0 || m_array || m_stack.empty() )
+                return skipContainer();
+            const Slot slot = takeSlot();
+            if( slot.kind == FieldKind::Vec2 || slot.kind == FieldKind::Vec4 )
+            {
+                m_array = slotPtr( slot );
+                m_arrayKind = FieldKind::Float;
+                m_arrayCount = slot.kind == FieldKind::Vec2 ? 2 : 4;
+                m_arrayIndex = 0;
+                return true;
+            }
+            if( slot.field && slot.field->arrayCount > 0 )
+            {
+                m_array = slotPtr( slot );
+                m_arrayKind = slot.field->arrayElement;
+                m_arrayCount = slot.field->arrayCount;
+                m_arrayIndex = 0;
+                return true;
+            }
+            if( slot.kind == FieldKind::Vector && slot.field && slot.field->element )
+            {
+                void* container = slotPtr( slot );
+                slot.field->element->resize( container, 0 );
+                m_stack.push_back( Frame{ container, nullptr, slot.field->element } );
+                return true;
+            }
+            return skipContainer();
+        }
+
+        bool end_array() override
+        {
+            if( m_skipDepth > 0 )
+                m_skipDepth--;
+            else if( m_array )
+                m_array = nullptr;
+            else
+                m_stack.pop_back();
+            return true;
+        }
+
+        bool parse_error( std::size_t, const std::string&, const nlohmann::detail::exception& ex ) override
+        {
+            m_error = ex.what();
+            return false;
+        }
+
+    private:
+        struct Frame
+        {
+            void* object;               // reflected object, or the std::vector when 'vector' is set
+            const TypeMeta* type;
+            const VectorMeta* vector;
+        };
+
+        // Where the next value goes: a field of the current object, or a new element of the current vector.
+        struct Slot
+        {
+            FieldKind kind = FieldKind::Unsupported;
+            const FieldMeta* field = nullptr;       // object member (carries the ranges), nullptr for vector elements
+            const TypeMeta* nested = nullptr;       // kind == FieldKind::Object
+        };
+
+        bool skipContainer()
+        {
+            m_skipDepth++;
+            m_pending = nullptr;
+            return true;
+        }
+
+        bool skipValue()
+        {
+            m_pending = nullptr;
+            return true;
+        }
+
+        // A value of a fixed-size array that is not stored: the next one still goes to the next element.
+        bool skipArrayElement()
+        {
+            if( m_skipDepth == 0 )
+                m_arrayIndex++;
+            return true;
+        }
+
+        Slot takeSlot()
+        {
+            Slot slot;
+            if( m_skipDepth > 0 || m_stack.empty() )
+                return slot;
+            if( const VectorMeta* vector = m_stack.back().vector )
+            {
+                slot.kind = vector->elementKind;
+                slot.nested = vector->elementNested;
+            }
+            else if( m_pending )
+            {
+                slot.kind = m_pending->kind;
+                slot.field = m_pending;
+                slot.nested = m_pending->nested;
+            }
+            m_pending = nullptr;
+            return slot;
+        }
+
+        // Address to store the slot's value at; appends the element for vectors.
+        void* slotPtr( const Slot& slot )
+        {
+            Frame& frame = m_stack.back();
+            if( slot.field )
+                return slot.field->ptr( frame.object );
+            const std::size_t index = frame.vector->size( frame.object );
+            frame.vector->resize( frame.object, index + 1 );
+            return frame.vector->at( frame.object, index );
+        }
+
+        bool storeBool( bool value )
+        {
+            if( m_skipDepth == 0 && m_array )
+            {
+                if( m_arrayKind == FieldKind::Bool && m_arrayIndex < m_arrayCount )
+                    static_cast< bool* >(m_array)[ m_arrayIndex ] = value;
+                m_arrayIndex++;
+                return true;
+            }
+            const Slot slot = takeSlot();
+            if( slot.kind == FieldKind::Bool )
+                *static_cast< bool* >(slotPtr( slot )) = value;
+            return true;
+        }
+
+        // 'texture' is the exact integer for ImTextureID members, only set for integer literals.
+        bool storeNumber( double value, bool integral, ImTextureID texture )
+        {
+            if( m_skipDepth == 0 && m_array )
+            {
+                if( m_arrayIndex < m_arrayCount && m_arrayKind == FieldKind::Float )
+                    static_cast< float* >(m_array)[ m_arrayIndex ] = numberToFloat( value, nullptr );
+                else if( m_arrayIndex < m_arrayCount && m_arrayKind == FieldKind::Int )
+                    numberToInt( value, nullptr, static_cast< int* >(m_array)[ m_arrayIndex ] );
+                m_arrayIndex++;
+                return true;
+            }
+            const Slot slot = takeSlot();
+            switch( slot.kind )
+            {
+            case FieldKind::Int:
+            {
+                int* member = static_cast< int* >(slotPtr( slot ));     // a vector element is appended even if the value is NaN
+                numberToInt( value, slot.field, *member );
+                break;
+            }
+            case FieldKind::Float:
+                *static_cast< float* >(slotPtr( slot )) = numberToFloat( value, slot.field );
+                break;
+            case FieldKind::Texture:
+            {
+                ImTextureID* member = static_cast< ImTextureID* >(slotPtr( slot ));
+                if( integral )
+                    *member = texture;
+                break;
+            }
+            default:
+                break;
+            }
+            return true;
+        }
+
+        bool storeString( string_t& value )
+        {
+            if( m_skipDepth == 0 && m_array )
+                return skipArrayElement();
+            const Slot slot = takeSlot();
+            if( slot.kind == FieldKind::String )
+                static_cast< std::string* >(slotPtr( slot ))->swap( value );
+            return true;
+        }
+
+        void* m_root;
+        const TypeMeta& m_rootType;
+        std::vector<Frame> m_stack;
+        const FieldMeta* m_pending = nullptr;
+        void* m_array = nullptr;                // ImVec2/ImVec4 or C array being filled
+        FieldKind m_arrayKind = FieldKind::Float;
+        std::size_t m_arrayCount = 0;
+        std::size_t m_arrayIndex = 0;
+        int m_skipDepth = 0;
+        bool m_started = false;
+        std::string m_error;
+    };
+
+    // Loads obj from JSON text produced by dumpJson(). 'input' is anything nlohmann::json::sax_parse() accepts
+    // (std::string, const char*, std::istream&, ...). Returns false and fills 'error' (if given) on a syntax error;
+    // fields read before the error keep their new values.
+    template<typename T, typename InputType>
+    bool fromJson( T& obj, InputType&& input, std::string* error = nullptr )
+    {
+        JsonReader reader( &obj, getTypeMeta<T>() );
+        const bool ok = json::sax_parse( std::forward<InputType>( input ), &reader );
+        if( !ok && error )
+            *error = reader.error();
+        return ok;
+    }
+} // namespace ReflectiveJson
@@ -0,0 +1,209 @@
+// ReflectiveJson snapshot bridge: lets a simulation thread own a reflected object while the UI thread inspects it.
+//
+// - The simulation thread publish()es a copy of its object whenever it likes. publish() never blocks: it writes into
+//   a back buffer and swaps it with the shared middle buffer through one atomic exchange (triple buffering).
+// - The UI thread acquire()s the latest published copy. That copy belongs to the UI until the next acquire(), so
+//   DrawImGui() can read and edit it without racing the simulation.
+// - UI edits recorded in a ChangeList are turned into field-level writes (byte offset + value) by queueWrites() and
+//   passed back through a lock-free single-producer/single-consumer ring. The simulation applies them at a point of
+//   its choosing with applyPendingWrites(), e.g. at the start of a tick.
+// - Until the simulation reports (through the published copies) that a write was applied, acquire() re-applies it on
+//   top of every newer snapshot, so an edit does not flicker back to the old value for a few frames.
+//
+// One simulation thread and one UI thread per bridge. Supported leaf kinds: bool, int, float, ImVec2, ImVec4,
+// ImTextureID, std::string, and std::vector elements of those.
+//
+// Usage:
+//   static ReflectiveJson::SnapshotBridge<Light> bridge;
+//   // simulation thread, each tick:
+//   bridge.applyPendingWrites( light );
+//   simulate( light );
+//   bridge.publish( light );
+//   // UI thread, each frame:
+//   static ReflectiveJson::ChangeList changes;
+//   Light& shown = bridge.acquire();
+//   if( ReflectiveJson::DrawImGui( shown, changes ) )
+//   {
+//       bridge.queueWrites( shown, changes );
+//       changes.clear();
+//   }
+
+#pragma once
+
+#include "reflective_json.h"
+#include <atomic>
+#include <cstring>
+
+namespace ReflectiveJson
+{
+    // One edited leaf value, detached from the object it was read from.
+    struct FieldWrite
+    {
+        std::size_t offset = 0;                         // byte offset of the member from the root object
+        const FieldMeta* field = nullptr;
+        std::size_t elementIndex = FieldChange::npos;   // field->kind == FieldKind::Vector: element to write
+        std::uint64_t seq = 0;                          // increasing per bridge, 1 for the first write
+        alignas(16) unsigned char bytes[ 16 ] = {};     // trivially copyable kinds
+        std::string text;                               // FieldKind::String
+    };
+
+    namespace detail
+    {
+        // Copies the current value of the changed leaf into 'write'. False for unsupported kinds.
+        inline bool captureWrite( const void* root, const FieldChange& change, FieldWrite& write )
+        {
+            if( !change.field )
+                return false;
+            write.offset = change.offset;
+            write.field = change.field;
+            write.elementIndex = change.elementIndex;
+            FieldKind kind;
+            const void* src = leafPtr( const_cast< void* >(root), write.offset, write.field, write.elementIndex, kind );
+            if( !src )
+                return false;
+            if( kind == FieldKind::String )
+            {
+                write.text = *static_cast< const std::string* >(src);
+                return true;
+            }
+            const std::size_t size = leafSize( kind );
+            if( size == 0 )
+                return false;
+            std::memcpy( write.bytes, src, size );
+            return true;
+        }
+
+        inline void applyWrite( void* root, const FieldWrite& write )
+        {
+            FieldKind kind;
+            void* dst = leafPtr( root, write.offset, write.field, write.elementIndex, kind );
+            if( !dst )
+                return;
+            if( kind == FieldKind::String )
+                *static_cast< std::string* >(dst) = write.text;
+            else
+                std::memcpy( dst, write.bytes, leafSize( kind ) );
+        }
+    } // namespace detail
+
+    template<typename T>
+    class SnapshotBridge
+    {
+    public:
+        static constexpr std::size_t QueueCapacity = 1024;     // power of two
+
+        explicit SnapshotBridge( const T& initial = T{} )
+        {
+            for( Slot& slot : m_slots )
+                slot.value = initial;
+        }
+
+        SnapshotBridge( const SnapshotBridge& ) = delete;
+        SnapshotBridge& operator=( const SnapshotBridge& ) = delete;
+
+        // ---------- Simulation thread ----------
+
+        // Makes a copy of 'state' the latest snapshot. Wait-free apart from the copy itself.
+        void publish( const T& state )
+        {
+            Slot& back = m_slots[ m_back ];
+            back.value = state;
+            back.appliedSeq = m_appliedSeq;
+            m_back = m_middle.exchange( ( std::uint8_t )(m_back | FreshBit), std::memory_order_acq_rel ) & IndexMask;
+        }
+
+        // Applies the UI edits queued since the last call to 'state'. Returns the number of writes applied.
+        int applyPendingWrites( T& state )
+        {
+            int count = 0;
+            std::size_t tail = m_queueTail.load( std::memory_order_relaxed );
+            const std::size_t head = m_queueHead.load( std::memory_order_acquire );
+            for( ; tail != head; tail++, count++ )
+            {
+                FieldWrite& write = m_queue[ tail & (QueueCapacity - 1) ];
+                detail::applyWrite( &state, write );
+                m_appliedSeq = write.seq;
+            }
+            m_queueTail.store( tail, std::memory_order_release );
+            return count;
+        }
+
+        // ---------- UI thread ----------
+
+        // Latest published snapshot, with the UI edits the simulation has not applied yet on top.
+        // The reference stays valid and untouched by other threads until the next acquire().
+        T& acquire()
+        {
+            if( m_middle.load( std::memory_order_relaxed ) & FreshBit )
+                m_front = m_middle.exchange( m_front, std::memory_order_acq_rel ) & IndexMask;
+            Slot& front = m_slots[ m_front ];
+
+            flush();
+            std::size_t applied = 0;
+            while( applied < m_inFlight.size() && m_inFlight[ applied ].seq <= front.appliedSeq )
+                applied++;
+            m_inFlight.erase( m_inFlight.begin(), m_inFlight.begin() + ( std::ptrdiff_t )applied );
+            for( const FieldWrite& write : m_inFlight )
+                detail::applyWrite( &front.value, write );
+            return front.value;
+        }
+
+        // Queues the recorded changes of 'edited' (usually the object returned by acquire()) for the simulation.
+        void queueWrites( const T& edited, const ChangeList& changes )
+        {
+            for( const FieldChange& change : changes.changes )
+            {
+                FieldWrite write;
+                if( !detail::captureWrite( &edited, change, write ) )
+                    continue;
+                write.seq = ++m_lastSeq;
+                m_inFlight.push_back( write );
+                m_outbox.push_back( std::move( write ) );
+            }
+            flush();
+        }
+
+        // Writes queued by the UI and not yet applied by the simulation.
+        std::size_t pendingWrites() const { return m_inFlight.size(); }
+
+    private:
+        static constexpr std::uint8_t IndexMask = 0x3;
+        static constexpr std::uint8_t FreshBit = 0x4;
+
+        struct Slot
+        {
+            T value;
+            std::uint64_t appliedSeq = 0;       // last UI write applied to the simulation state this copy was taken from
+        };
+
+        // Moves as many outbox writes as fit into the ring; the rest waits for the next acquire() / queueWrites().
+        void flush()
+        {
+            std::size_t head = m_queueHead.load( std::memory_order_relaxed );
+            const std::size_t tail = m_queueTail.load( std::memory_order_acquire );
+            std::size_t sent = 0;
+            for( ; sent < m_outbox.size() && head - tail < QueueCapacity; sent++, head++ )
+                m_queue[ head & (QueueCapacity - 1) ] = std::move( m_outbox[ sent ] );
+            m_queueHead.store( head, std::memory_order_release );
+            m_outbox.erase( m_outbox.begin(), m_outbox.begin() + ( std::ptrdiff_t )sent );
+        }
+
+        // Triple buffer: the simulation owns m_slots[ m_back ], the UI owns m_slots[ m_front ], the third one is
+        // exchanged through m_middle (index + FreshBit when it holds a snapshot the UI has not taken yet).
+        Slot m_slots[ 3 ];
+        std::uint8_t m_back = 0;
+        std::atomic<std::uint8_t> m_middle{ 1 };
+        std::uint8_t m_front = 2;
+        std::uint64_t m_appliedSeq = 0;         // simulation side
+
+        // UI -> simulation ring. m_queueHead is written by the UI, m_queueTail by the simulation.
+        FieldWrite m_queue[ QueueCapacity ];
+        alignas(64) std::atomic<std::size_t> m_queueHead{ 0 };
+        alignas(64) std::atomic<std::size_t> m_queueTail{ 0 };
+
+        // UI side
+        std::vector<FieldWrite> m_outbox;       // captured, not yet in the ring
+        std::vector<FieldWrite> m_inFlight;     // sent, not yet reported as applied; ascending seq
+        std::uint64_t m_lastSeq = 0;
+    };
+} // namespace ReflectiveJson
@@ -0,0 +1,212 @@
+// ReflectiveJson instance table: one row per object, one column per field, for pools of identical structs.
+//
+// Only the visible rows are submitted (ImGuiListClipper over a fixed row height), so the frame cost depends on the
+// window height, not on the number of instances. Clicking a column header sorts by that field (shift-click adds
+// secondary keys). Sorting permutes an index array kept in InstanceTableState; the objects themselves never move.
+// Rows are not re-sorted while their values are edited, only when the sort specs or the instance count change.
+// Rows can be selected through the index column (click, ctrl/shift-click, box-select); see collectSelection().
+//
+// Usage:
+//   static std::vector<Light> lights( 200000 );
+//   static ReflectiveJson::InstanceTableState lightsTable;
+//   int edited = ReflectiveJson::DrawInstanceTable( "##lights", lights, lightsTable );   // index of the edited light, or -1
+//   ReflectiveJson::collectSelection( lightsTable, selected );                            // indices of the selected lights
+
+#pragma once
+
+#include "reflective_json.h"
+#include <algorithm>
+
+namespace ReflectiveJson
+{
+    struct InstanceTableState
+    {
+        std::vector<int> order;         // display row -> instance index
+        bool sorted = false;            // order follows the table sort specs (false: identity order)
+        ImGuiSelectionBasicStorage selection;   // selected instance indices (as ImGuiID)
+    };
+
+    // Indices of the selected instances, ascending.
+    inline void collectSelection( InstanceTableState& state, std::vector<int>& out )
+    {
+        out.clear();
+        out.reserve( ( std::size_t )state.selection.Size );
+        void* it = nullptr;
+        ImGuiID id;
+        while( state.selection.GetNextSelectedItem( &it, &id ) )
+            out.push_back( ( int )id );
+        std::sort( out.begin(), out.end() );
+    }
+
+    namespace detail
+    {
+        // Deselects the instances >= count (objects removed since the selection was made).
+        inline void dropSelectionFrom( ImGuiSelectionBasicStorage& selection, int count )
+        {
+            std::vector<ImGuiID> stale;
+            void* it = nullptr;
+            ImGuiID id;
+            while( selection.GetNextSelectedItem( &it, &id ) )
+                if( id >= ( ImGuiID )count )
+                    stale.push_back( id );
+            for( ImGuiID staleId : stale )
+                selection.SetItemSelected( staleId, false );
+        }
+
+        inline bool isSortable( FieldKind kind )
+        {
+            switch( kind )
+            {
+            case FieldKind::Bool:
+            case FieldKind::Int:
+            case FieldKind::Float:
+            case FieldKind::String:
+            case FieldKind::Texture:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // <0, 0, >0 like strcmp, for two members of a sortable kind.
+        inline int compareValues( FieldKind kind, const void* a, const void* b )
+        {
+            switch( kind )
+            {
+            case FieldKind::Bool:   return ( int )*static_cast< const bool* >(a) - ( int )*static_cast< const bool* >(b);
+            case FieldKind::Int:
+            {
+                const int x = *static_cast< const int* >(a), y = *static_cast< const int* >(b);
+                return (x > y) - (x < y);
+            }
+            case FieldKind::Float:
+            {
+                const float x = *static_cast< const float* >(a), y = *static_cast< const float* >(b);
+                return (x > y) - (x < y);
+            }
+            case FieldKind::String: return static_cast< const std::string* >(a)->compare( *static_cast< const std::string* >(b) );
+            case FieldKind::Texture:
+            {
+                const ImTextureID x = *static_cast< const ImTextureID* >(a), y = *static_cast< const ImTextureID* >(b);
+                return (x > y) - (x < y);
+            }
+            default:                return 0;
+            }
+        }
+
+        // Column user ID 0 is the instance index, N > 0 is field N - 1.
+        template<typename T>
+        void sortInstances( const T* objects, const ImGuiTableSortSpecs& specs, std::vector<int>& order )
+        {
+            const auto& fields = getTypeMeta<T>().fields;
+            std::stable_sort( order.begin(), order.end(), [&]( int a, int b )
+            {
+                for( int s = 0; s < specs.SpecsCount; s++ )
+                {
+                    const ImGuiTableColumnSortSpecs& spec = specs.Specs[ s ];
+                    int delta;
+                    if( spec.ColumnUserID == 0 )
+                    {
+                        delta = (a > b) - (a < b);
+                    }
+                    else
+                    {
+                        const FieldMeta& field = *fields[ spec.ColumnUserID - 1 ];
+                        delta = compareValues( field.kind, field.ptr( &objects[ a ] ), field.ptr( &objects[ b ] ) );
+                    }
+                    if( delta != 0 )
+                        return spec.SortDirection == ImGuiSortDirection_Ascending ? delta < 0 : delta > 0;
+                }
+                return a < b;
+            } );
+        }
+    } // namespace detail
+
+    // Table of 'count' objects. Returns the index (into objects) of the instance edited this frame, or -1.
+    template<typename T>
+    int DrawInstanceTable( const char* strId, T* objects, int count, InstanceTableState& state, const ImVec2& size = ImVec2( 0.0f, 0.0f ) )
+    {
+        static_assert( has_getFields_v<T>, "DrawInstanceTable needs a reflected type" );
+        const TypeMeta& type = getTypeMeta<T>();
+        const ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_ScrollX | ImGuiTableFlags_RowBg |
+            ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable |
+            ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti;
+        if( !ImGui::BeginTable( strId, 1 + ( int )type.fields.size(), flags, size ) )
+            return -1;
+
+        ImGui::TableSetupScrollFreeze( 1, 1 );
+        ImGui::TableSetupColumn( "#", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort, 0.0f, 0 );
+        for( std::size_t i = 0; i < type.fields.size(); i++ )
+        {
+            const FieldMeta& field = *type.fields[ i ];
+            ImGuiTableColumnFlags columnFlags = ImGuiTableColumnFlags_WidthStretch;
+            if( !detail::isSortable( field.kind ) )
+                columnFlags |= ImGuiTableColumnFlags_NoSort;
+            ImGui::TableSetupColumn( field.name, columnFlags, 0.0f, ( ImGuiID )(i + 1) );
+        }
+        ImGui::TableHeadersRow();
+
+        if( state.order.size() != ( std::size_t )count )
+        {
+            state.order.resize( ( std::size_t )count );
+            for( int i = 0; i < count; i++ )
+                state.order[ i ] = i;
+            state.sorted = false;
+            detail::dropSelectionFrom( state.selection, count );
+        }
+        if( ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs() )
+        {
+            if( specs->SpecsDirty || !state.sorted )
+            {
+                detail::sortInstances( objects, *specs, state.order );
+                specs->SpecsDirty = false;
+                state.sorted = true;
+            }
+        }
+
+        // Multi-select items are display rows; the storage keeps instance indices so that sorting keeps the selection.
+        state.selection.UserData = &state;
+        state.selection.AdapterIndexToStorageId = []( ImGuiSelectionBasicStorage* storage, int row )
+        {
+            return ( ImGuiID )static_cast< InstanceTableState* >(storage->UserData)->order[ row ];
+        };
+        ImGuiMultiSelectIO* multiSelect = ImGui::BeginMultiSelect( ImGuiMultiSelectFlags_ClearOnEscape | ImGuiMultiSelectFlags_BoxSelect1d,
+            state.selection.Size, count );
+        state.selection.ApplyRequests( multiSelect );
+
+        int edited = -1;
+        const float rowHeight = ImGui::GetFrameHeightWithSpacing();
+        ImGuiListClipper clipper;
+        clipper.Begin( count, rowHeight );
+        if( multiSelect->RangeSrcItem != -1 )
+            clipper.IncludeItemByIndex( ( int )multiSelect->RangeSrcItem );
+        while( clipper.Step() )
+        {
+            for( int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++ )
+            {
+                const int index = state.order[ row ];
+                ImGui::PushID( index );
+                ImGui::TableNextRow( ImGuiTableRowFlags_None, rowHeight );
+                ImGui::TableNextColumn();
+                char label[ 16 ];
+                ImFormatString( label, IM_ARRAYSIZE( label ), "%d", index );
+                ImGui::SetNextItemSelectionUserData( row );
+                ImGui::Selectable( label, state.selection.Contains( ( ImGuiID )index ),
+                    ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2( 0.0f, ImGui::GetFrameHeight() ) );
+                if( drawTableCells( objects[ index ] ) )
+                    edited = index;
+                ImGui::PopID();
+            }
+        }
+        multiSelect = ImGui::EndMultiSelect();
+        state.selection.ApplyRequests( multiSelect );
+        ImGui::EndTable();
+        return edited;
+    }
+
+    template<typename T>
+    int DrawInstanceTable( const char* strId, std::vector<T>& objects, InstanceTableState& state, const ImVec2& size = ImVec2( 0.0f, 0.0f ) )
+    {
+        return DrawInstanceTable( strId, objects.data(), ( int )objects.size(), state, size );
+    }
+} // namespace ReflectiveJson
@@ -0,0 +1,251 @@
+// ReflectiveJson undo/redo: a journal of field-level binary deltas kept in a fixed-size byte ring.
+//
+// Each record holds the edited leaf (root object, FieldMeta, byte offset, vector element index) and the leaf's bytes
+// before and after the edit (the characters for std::string). A continuous edit of one widget (a drag, typing into a
+// text field) is coalesced into a single record: its 'before' stays the value from when the widget was activated.
+// When the byte budget is exceeded the oldest records are dropped, so memory never grows during a session.
+//
+// Usage:
+//   static ReflectiveJson::UndoJournal journal( 64 * 1024 );
+//   static ReflectiveJson::ChangeList changes;
+//   journal.attach( changes );                     // once
+//   journal.newFrame();                            // each frame, before drawing
+//   ReflectiveJson::DrawImGui( material, changes );
+//   if( ctrl+z ) journal.undo();
+//   if( ctrl+y ) journal.redo();
+//
+// Records point at the edited objects: objects must outlive the journal or be followed by clear().
+
+#pragma once
+
+#include "reflective_json.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ReflectiveJson
+{
+    class UndoJournal
+    {
+    public:
+        explicit UndoJournal( std::size_t byteBudget = 64 * 1024 )
+            : m_ring( byteBudget ) {}
+
+        UndoJournal( const UndoJournal& ) = delete;
+        UndoJournal& operator=( const UndoJournal& ) = delete;
+
+        // Records the edits drawn through DrawImGui( obj, changes ).
+        void attach( ChangeList& changes )
+        {
+            changes.observer = &UndoJournal::onEdit;
+            changes.observerUser = this;
+        }
+
+        // Ends the coalescing of the previous edit once its widget is no longer active. Call once per frame.
+        void newFrame()
+        {
+            if( m_coalesceId != 0 && ImGui::GetActiveID() != m_coalesceId )
+                m_coalesceId = 0;
+        }
+
+        bool canUndo() const { return m_cursor != m_begin; }
+        bool canRedo() const { return m_cursor != m_end; }
+
+        // Restores the value from before the most recent edit. Returns false if there is nothing to undo.
+        bool undo()
+        {
+            if( !canUndo() )
+                return false;
+            const std::uint64_t start = m_cursor - readFooter( m_cursor );
+            Header header;
+            read( start, &header, sizeof( header ) );
+            applyValue( header, start + sizeof( header ), header.oldSize );
+            m_cursor = start;
+            m_coalesceId = 0;
+            return true;
+        }
+
+        bool redo()
+        {
+            if( !canRedo() )
+                return false;
+            Header header;
+            read( m_cursor, &header, sizeof( header ) );
+            applyValue( header, m_cursor + sizeof( header ) + header.oldSize, header.newSize );
+            m_cursor += recordSize( header );
+            m_coalesceId = 0;
+            return true;
+        }
+
+        void clear()
+        {
+            m_begin = m_cursor = m_end = 0;
+            m_coalesceId = 0;
+        }
+
+        std::size_t budget() const      { return m_ring.size(); }
+        std::size_t bytesUsed() const   { return ( std::size_t )(m_end - m_begin); }
+        int undoCount() const           { return countRecords( m_begin, m_cursor ); }
+        int redoCount() const           { return countRecords( m_cursor, m_end ); }
+
+    private:
+        struct Header
+        {
+            void* root;
+            const FieldMeta* field;
+            std::uint64_t offset;
+            std::uint64_t elementIndex;
+            std::uint32_t oldSize;
+            std::uint32_t newSize;
+        };
+        using Footer = std::uint32_t;       // total record size, to walk back from m_cursor
+
+        static std::size_t recordSize( const Header& header )
+        {
+            return sizeof( Header ) + header.oldSize + header.newSize + sizeof( Footer );
+        }
+
+        // Bytes of a leaf: the raw value, or the characters of a std::string.
+        static bool leafBytes( FieldKind kind, const void* leaf, const void*& data, std::size_t& size )
+        {
+            if( kind == FieldKind::String )
+            {
+                const std::string& str = *static_cast< const std::string* >(leaf);
+                data = str.data();
+                size = str.size();
+                return true;
+            }
+            data = leaf;
+            size = leafSize( kind );
+            return size != 0;
+        }
+
+        static void onEdit( void* user, void* root, const FieldChange& change, const void* before, const void* after )
+        {
+            static_cast< UndoJournal* >(user)->record( root, change, before, after );
+        }
+
+        void record( void* root, const FieldChange& change, const void* before, const void* after )
+        {
+            if( !change.field )
+                return;
+            FieldKind kind;
+            if( !leafPtr( root, change.offset, change.field, change.elementIndex, kind ) )
+                return;
+
+            const ImGuiID activeId = ImGui::GetActiveID();
+            const void* newData;
+            std::size_t newSize;
+            if( !leafBytes( kind, after, newData, newSize ) )
+                return;
+
+            // Same widget still active on the same leaf: replace the newest record, keeping its 'before'.
+            if( m_coalesceId != 0 && m_coalesceId == activeId && m_cursor == m_end && canUndo() )
+            {
+                const std::uint64_t start = m_cursor - readFooter( m_cursor );
+                Header last;
+                read( start, &last, sizeof( last ) );
+                if( last.root == root && last.offset == change.offset && last.elementIndex == change.elementIndex )
+                {
+                    m_scratch.resize( last.oldSize );
+                    read( start + sizeof( last ), m_scratch.data(), last.oldSize );
+                    m_cursor = m_end = start;
+                    push( root, change, m_scratch.data(), m_scratch.size(), newData, newSize );
+                    return;
+                }
+            }
+
+            const void* oldData;
+            std::size_t oldSize;
+            if( !before || !leafBytes( kind, before, oldData, oldSize ) )
+                return;
+            push( root, change, oldData, oldSize, newData, newSize );
+            m_coalesceId = activeId;
+        }
+
+        void push( void* root, const FieldChange& change, const void* oldData, std::size_t oldSize, const void* newData, std::size_t newSize )
+        {
+            const Header header{ root, change.field, change.offset, change.elementIndex, ( std::uint32_t )oldSize, ( std::uint32_t )newSize };
+            const std::size_t size = recordSize( header );
+            m_end = m_cursor;                   // a new edit discards the redo records
+            if( size > m_ring.size() )
+            {
+                clear();                        // can't be kept; older records would no longer undo in order
+                return;
+            }
+            while( m_end + size - m_begin > m_ring.size() )
+            {
+                Header oldest;
+                read( m_begin, &oldest, sizeof( oldest ) );
+                m_begin += recordSize( oldest );
+            }
+            const Footer footer = ( Footer )size;
+            std::uint64_t pos = m_end;
+            write( pos, &header, sizeof( header ) );        pos += sizeof( header );
+            write( pos, oldData, oldSize );                 pos += oldSize;
+            write( pos, newData, newSize );                 pos += newSize;
+            write( pos, &footer, sizeof( footer ) );
+            m_end = m_cursor = m_end + size;
+        }
+
+        void applyValue( const Header& header, std::uint64_t pos, std::uint32_t size )
+        {
+            FieldKind kind;
+            void* leaf = leafPtr( header.root, ( std::size_t )header.offset, header.field, ( std::size_t )header.elementIndex, kind );
+            if( !leaf )
+                return;
+            if( kind == FieldKind::String )
+            {
+                std::string& str = *static_cast< std::string* >(leaf);
+                str.resize( size );
+                read( pos, str.data(), size );
+            }
+            else if( leafSize( kind ) == size )
+            {
+                read( pos, leaf, size );
+            }
+        }
+
+        Footer readFooter( std::uint64_t end ) const
+        {
+            Footer footer;
+            read( end - sizeof( footer ), &footer, sizeof( footer ) );
+            return footer;
+        }
+
+        int countRecords( std::uint64_t from, std::uint64_t to ) const
+        {
+            int count = 0;
+            for( ; from != to; count++ )
+            {
+                Header header;
+                read( from, &header, sizeof( header ) );
+                from += recordSize( header );
+            }
+            return count;
+        }
+
+        // Positions grow monotonically; the byte at position p lives at m_ring[ p % size ].
+        void write( std::uint64_t pos, const void* data, std::size_t size )
+        {
+            const std::size_t at = ( std::size_t )(pos % m_ring.size());
+            const std::size_t first = std::min( size, m_ring.size() - at );
+            std::memcpy( m_ring.data() + at, data, first );
+            std::memcpy( m_ring.data(), static_cast< const char* >(data) + first, size - first );
+        }
+
+        void read( std::uint64_t pos, void* data, std::size_t size ) const
+        {
+            const std::size_t at = ( std::size_t )(pos % m_ring.size());
+            const std::size_t first = std::min( size, m_ring.size() - at );
+            std::memcpy( data, m_ring.data() + at, first );
+            std::memcpy( static_cast< char* >(data) + first, m_ring.data(), size - first );
+        }
+
+        std::vector<unsigned char> m_ring;
+        std::uint64_t m_begin = 0;          // oldest record
+        std::uint64_t m_cursor = 0;         // records in [m_begin, m_cursor) can be undone, [m_cursor, m_end) redone
+        std::uint64_t m_end = 0;
+        ImGuiID m_coalesceId = 0;           // active widget of the newest record, 0 once it was deactivated
+        std::vector<char> m_scratch;
+    };
+} // namespace ReflectiveJson
@@ -0,0 +1,336 @@
+// TextureGen: procedural placeholder textures (solid, checker, gradient) generated off the render thread.
+//
+// - Fill kernels write 4 pixels per store (SSE2 / NEON, scalar otherwise); a checker is two template rows copied
+//   down the image, so the cost per texture is about one memcpy of its pixels.
+// - Requested textures are generated in batches on a ReflectiveJson::ThreadPool (one texture per task), into one
+//   pixel arena that is reused from batch to batch, while the render thread keeps drawing frames.
+// - Texture objects come from a pool keyed by size and format: releasing a texture keeps it for the next request of
+//   the same size instead of deleting it, so regenerating on resize does not churn texture IDs.
+// - The renderer supplies create / upload / destroy callbacks; they are only called from the thread calling
+//   request(), update(), release() and clear() (the thread owning the graphics context).
+//
+// Usage:
+//   TextureGen::TextureGenerator textures( { CreateTexture, UploadTexture, DestroyTexture, nullptr } );
+//   ImTextureID tex = textures.request( TextureGen::TextureDesc::Checker( 164, 164, 8, IM_COL32( 255, 255, 255, 255 ), IM_COL32( 100, 100, 100, 255 ) ) );
+//   // every frame:
+//   textures.update();             // uploads finished textures, starts generating the pending ones
+//   // shutdown, while the graphics context is alive:
+//   textures.clear();
+
+#pragma once
+
+#include "imgui.h"
+#include "reflective_json_parallel.h"
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_GEN_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TEXTURE_GEN_NEON
+#endif
+
+namespace TextureGen
+{
+    enum class TextureFormat : int
+    {
+        RGBA8,                      // one ImU32 (IM_COL32) per pixel
+    };
+
+    enum class Pattern : int
+    {
+        Solid,                      // colorA
+        Checker,                    // cellSize x cellSize squares, colorA on the top-left one
+        Gradient,                   // colorA on the top row to colorB on the bottom row
+    };
+
+    struct TextureDesc
+    {
+        int width = 1;
+        int height = 1;
+        Pattern pattern = Pattern::Solid;
+        ImU32 colorA = IM_COL32_WHITE;
+        ImU32 colorB = IM_COL32_BLACK;
+        int cellSize = 8;
+        TextureFormat format = TextureFormat::RGBA8;
+
+        static TextureDesc Solid( int width, int height, ImU32 color ) { return { width, height, Pattern::Solid, color, color }; }
+        static TextureDesc Checker( int width, int height, int cellSize, ImU32 colorA, ImU32 colorB ) { return { width, height, Pattern::Checker, colorA, colorB, cellSize }; }
+        static TextureDesc Gradient( int width, int height, ImU32 top, ImU32 bottom ) { return { width, height, Pattern::Gradient, top, bottom }; }
+    };
+
+    // Renderer hooks. create() makes a texture object for width x height pixels of 'format' (contents undefined),
+    // upload() replaces all its pixels, destroy() deletes it.
+    struct TextureBackend
+    {
+        ImTextureID( *create )(int width, int height, TextureFormat format, void* user) = nullptr;
+        void ( *upload )(ImTextureID texture, int width, int height, TextureFormat format, const void* pixels, void* user) = nullptr;
+        void ( *destroy )(ImTextureID texture, void* user) = nullptr;
+        void* user = nullptr;
+    };
+
+    // ---------- Fill kernels ----------
+
+    // dst[ 0 .. count ) = color
+    inline void FillSpan( ImU32* dst, int count, ImU32 color )
+    {
+        int i = 0;
+#if defined(TEXTURE_GEN_SSE2)
+        const __m128i value = _mm_set1_epi32( ( int )color );
+        for( ; i + 4 <= count; i += 4 )
+            _mm_storeu_si128( reinterpret_cast< __m128i* >(dst + i), value );
+#elif defined(TEXTURE_GEN_NEON)
+        const uint32x4_t value = vdupq_n_u32( color );
+        for( ; i + 4 <= count; i += 4 )
+            vst1q_u32( dst + i, value );
+#endif
+        for( ; i < count; i++ )
+            dst[ i ] = color;
+    }
+
+    inline void FillSolid( ImU32* pixels, int width, int height, ImU32 color )
+    {
+        FillSpan( pixels, width * height, color );
+    }
+
+    inline void FillChecker( ImU32* pixels, int width, int height, int cellSize, ImU32 colorA, ImU32 colorB )
+    {
+        cellSize = ImMax( cellSize, 1 );
+        // The first row of the image and the first row of the next band of cells (colors swapped) ...
+        ImU32* rowA = pixels;
+        for( int x = 0; x < width; x += cellSize )
+            FillSpan( rowA + x, ImMin( cellSize, width - x ), ((x / cellSize) & 1) ? colorB : colorA );
+        if( height <= 1 )
+            return;
+        ImU32* rowB = pixels + ( std::size_t )ImMin( cellSize, height - 1 ) * width;
+        for( int x = 0; x < width; x += cellSize )
+            FillSpan( rowB + x, ImMin( cellSize, width - x ), ((x / cellSize) & 1) ? colorA : colorB );
+
+        // ... then copied to every other row
+        for( int y = 1; y < height; y++ )
+        {
+            ImU32* row = pixels + ( std::size_t )y * width;
+            const ImU32* source = ((y / cellSize) & 1) ? rowB : rowA;
+            if( row != source )
+                std::memcpy( row, source, ( std::size_t )width * sizeof( ImU32 ) );
+        }
+    }
+
+    inline void FillGradient( ImU32* pixels, int width, int height, ImU32 top, ImU32 bottom )
+    {
+        const ImVec4 a = ImGui::ColorConvertU32ToFloat4( top );
+        const ImVec4 b = ImGui::ColorConvertU32ToFloat4( bottom );
+        for( int y = 0; y < height; y++ )
+        {
+            const float t = height > 1 ? ( float )y / ( float )(height - 1) : 0.0f;
+            const ImU32 color = ImGui::ColorConvertFloat4ToU32( ImVec4( a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t ) );
+            FillSpan( pixels + ( std::size_t )y * width, width, color );
+        }
+    }
+
+    inline void Fill( ImU32* pixels, const TextureDesc& desc )
+    {
+        switch( desc.pattern )
+        {
+        case Pattern::Solid:        FillSolid( pixels, desc.width, desc.height, desc.colorA ); break;
+        case Pattern::Checker:      FillChecker( pixels, desc.width, desc.height, desc.cellSize, desc.colorA, desc.colorB ); break;
+        case Pattern::Gradient:     FillGradient( pixels, desc.width, desc.height, desc.colorA, desc.colorB ); break;
+        }
+    }
+
+    // ---------- Generator ----------
+
+    class TextureGenerator
+    {
+    public:
+        explicit TextureGenerator( const TextureBackend& backend, ReflectiveJson::ThreadPool& pool = ReflectiveJson::defaultThreadPool() )
+            : m_backend( backend ), m_pool( pool )
+        {
+        }
+
+        TextureGenerator( const TextureGenerator& ) = delete;
+        TextureGenerator& operator=( const TextureGenerator& ) = delete;
+
+        ~TextureGenerator()
+        {
+            clear();
+        }
+
+        // Returns a texture of desc's size at once; its pixels are uploaded by a later update().
+        ImTextureID request( const TextureDesc& desc )
+        {
+            TextureDesc valid = desc;
+            valid.width = ImMax( desc.width, 1 );
+            valid.height = ImMax( desc.height, 1 );
+            const ImTextureID texture = acquire( valid.width, valid.height, valid.format );
+            if( texture == ImTextureID_Invalid )
+                return texture;
+            const std::uint64_t ticket = ++m_lastTicket;
+            m_live[ texture ] = ticket;
+            m_pending.push_back( Job{ texture, ticket, valid, 0 } );
+            return texture;
+        }
+
+        // Gives 'texture' back to the pool and requests a new one for desc (the same object if the size is unchanged).
+        ImTextureID regenerate( ImTextureID texture, const TextureDesc& desc )
+        {
+            release( texture );
+            return request( desc );
+        }
+
+        // Returns a texture made by request() to the pool. A generation still in flight for it is dropped.
+        void release( ImTextureID texture )
+        {
+            auto it = m_live.find( texture );
+            if( it == m_live.end() )
+                return;
+            m_live.erase( it );
+            m_free[ m_sizes[ texture ] ].push_back( texture );
+        }
+
+        // Call once per frame. Uploads up to maxUploads generated textures, then starts the next batch when the
+        // previous one is fully uploaded. Returns the number of textures uploaded.
+        int update( int maxUploads = INT_MAX )
+        {
+            int uploaded = 0;
+            if( m_worker.joinable() )
+            {
+                if( !m_batchDone.load( std::memory_order_acquire ) )
+                    return uploaded;
+                m_worker.join();
+            }
+            for( ; m_nextUpload < m_batch.size() && uploaded < maxUploads; m_nextUpload++ )
+            {
+                const Job& job = m_batch[ m_nextUpload ];
+                auto live = m_live.find( job.texture );
+                if( live == m_live.end() || live->second != job.ticket )
+                    continue;               // released (and maybe requested again) since
+                m_backend.upload( job.texture, job.desc.width, job.desc.height, job.desc.format, m_arena.data() + job.offset, m_backend.user );
+                uploaded++;
+            }
+            if( m_nextUpload == m_batch.size() && !m_pending.empty() )
+                startBatch();
+            return uploaded;
+        }
+
+        // Generates and uploads everything requested so far.
+        void finish()
+        {
+            while( busy() )
+            {
+                if( m_worker.joinable() )
+                    m_worker.join();
+                update();
+            }
+        }
+
+        // True while requested textures are still waiting for their pixels.
+        bool busy() const { return !m_pending.empty() || m_worker.joinable() || m_nextUpload < m_batch.size(); }
+
+        // Number of texture objects alive (in use or pooled).
+        std::size_t textureCount() const { return m_sizes.size(); }
+
+        // Destroys every texture, in use or pooled.
+        void clear()
+        {
+            if( m_worker.joinable() )
+                m_worker.join();
+            if( m_backend.destroy )
+                for( const auto& entry : m_sizes )
+                    m_backend.destroy( entry.first, m_backend.user );
+            m_sizes.clear();
+            m_free.clear();
+            m_live.clear();
+            m_pending.clear();
+            m_batch.clear();
+            m_nextUpload = 0;
+        }
+
+    private:
+        struct Job
+        {
+            ImTextureID texture;
+            std::uint64_t ticket;   // matches m_live[ texture ] while the request is current
+            TextureDesc desc;
+            std::size_t offset;     // in m_arena, in pixels
+        };
+
+        struct SizeKey
+        {
+            int width;
+            int height;
+            TextureFormat format;
+
+            bool operator==( const SizeKey& other ) const { return width == other.width && height == other.height && format == other.format; }
+        };
+
+        struct SizeKeyHash
+        {
+            std::size_t operator()( const SizeKey& key ) const { return (( std::size_t )key.width * 73856093u) ^ (( std::size_t )key.height * 19349663u) ^ ( std::size_t )key.format; }
+        };
+
+        ImTextureID acquire( int width, int height, TextureFormat format )
+        {
+            const SizeKey key{ width, height, format };
+            auto it = m_free.find( key );
+            if( it != m_free.end() && !it->second.empty() )
+            {
+                const ImTextureID texture = it->second.back();
+                it->second.pop_back();
+                return texture;
+            }
+            const ImTextureID texture = m_backend.create( width, height, format, m_backend.user );
+            if( texture != ImTextureID_Invalid )
+                m_sizes[ texture ] = key;
+            return texture;
+        }
+
+        // Lays the pending jobs out in the arena and fills them on the pool, from a worker thread so the caller
+        // keeps running frames.
+        void startBatch()
+        {
+            m_batch.swap( m_pending );
+            m_pending.clear();
+            m_nextUpload = 0;
+            std::size_t pixels = 0;
+            for( Job& job : m_batch )
+            {
+                job.offset = pixels;
+                pixels += (( std::size_t )job.desc.width * job.desc.height + 3) & ~( std::size_t )3;    // each texture starts 16-byte aligned
+            }
+            if( m_arena.size() < pixels )
+                m_arena.resize( pixels );  // grows only: the arena is reused by every later batch
+
+            m_batchDone.store( false, std::memory_order_relaxed );
+            m_worker = std::thread( [this]()
+            {
+                m_pool.run( m_batch.size(), [this]( std::size_t i )
+                {
+                    const Job& job = m_batch[ i ];
+                    Fill( m_arena.data() + job.offset, job.desc );
+                } );
+                m_batchDone.store( true, std::memory_order_release );
+            } );
+        }
+
+        TextureBackend m_backend;
+        ReflectiveJson::ThreadPool& m_pool;
+        std::unordered_map<ImTextureID, SizeKey> m_sizes;                       // every texture object made
+        std::unordered_map<SizeKey, std::vector<ImTextureID>, SizeKeyHash> m_free; // released, by size
+        std::unordered_map<ImTextureID, std::uint64_t> m_live;                  // requested and not released
+        std::uint64_t m_lastTicket = 0;
+        std::vector<Job> m_pending;         // requested, waiting for the next batch
+        std::vector<Job> m_batch;           // being generated (m_worker) or uploaded (from m_nextUpload)
+        std::size_t m_nextUpload = 0;
+        std::vector<ImU32> m_arena;         // pixels of m_batch
+        std::thread m_worker;
+        std::atomic<bool> m_batchDone{ false };
+    };
+} // namespace TextureGen
@@ -0,0 +1,95 @@
+// VirtualList: scrolling lists of many editable entries (100k+) with a per-frame cost that depends only on the
+// visible rows.
+//
+// - ChunkedStore keeps the entries in fixed-size chunks: adding an entry never moves the existing ones (no
+//   reallocation copying every entry, and pointers handed to widgets stay valid), and memory grows one chunk at a time.
+// - DrawList() submits the rows through ImGuiListClipper with a fixed row height (one frame-height line per entry),
+//   so rows scrolled out of view cost nothing. Each row is scoped with PushID( int index ): widget labels inside the
+//   row can be plain literals ("Submit"), without formatting "Submit##42" strings every frame.
+// A row must stay on one line (use SameLine() between its widgets) for the fixed row height to hold.
+//
+// Usage:
+//   static VirtualList::ChunkedStore<MyComponent> components;
+//   if( ImGui::Button( "Add" ) )
+//       components.push_back( MyComponent() );
+//   VirtualList::DrawList( "##components", components, 10, []( int index, MyComponent& c )
+//   {
+//       ImGui::Text( "#%d", index + 1 );
+//       ImGui::SameLine();
+//       ImGui::InputText( "Text", c.text, IM_ARRAYSIZE( c.text ) );
+//   } );
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace VirtualList
+{
+    // Growable array of T in chunks of ChunkSize entries (a power of two).
+    template<typename T, std::size_t ChunkSize = 1024>
+    class ChunkedStore
+    {
+        static_assert( ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two" );
+
+    public:
+        T& push_back( const T& value )
+        {
+            if( m_size == m_chunks.size() * ChunkSize )
+                m_chunks.push_back( std::unique_ptr<T[]>( new T[ ChunkSize ] ) );
+            T& slot = (*this)[ m_size++ ];
+            slot = value;
+            return slot;
+        }
+
+        // Drops every entry; the chunks are kept for the next push_back() calls.
+        void clear()
+        {
+            for( std::size_t i = 0; i < m_size; i++ )
+                (*this)[ i ] = T();
+            m_size = 0;
+        }
+
+        T& operator[]( std::size_t index ) { return m_chunks[ index / ChunkSize ][ index % ChunkSize ]; }
+        const T& operator[]( std::size_t index ) const { return m_chunks[ index / ChunkSize ][ index % ChunkSize ]; }
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        std::size_t capacity() const { return m_chunks.size() * ChunkSize; }
+
+    private:
+        std::vector<std::unique_ptr<T[]>> m_chunks;
+        std::size_t m_size = 0;
+    };
+
+    // Scrolling child window showing 'visibleRows' rows of 'entries'. drawRow( int index, T& entry ) is called for
+    // the visible rows only, inside PushID( index ). Returns the number of rows submitted this frame.
+    template<typename Store, typename DrawRow>
+    int DrawList( const char* strId, Store& entries, int visibleRows, DrawRow&& drawRow )
+    {
+        const float rowHeight = ImGui::GetFrameHeightWithSpacing();
+        const int count = ( int )ImMin( entries.size(), ( std::size_t )INT_MAX );
+        const float height = rowHeight * ( float )ImClamp( count, 1, ImMax( visibleRows, 1 ) ) + ImGui::GetStyle().WindowPadding.y * 2.0f;
+        int drawn = 0;
+        if( ImGui::BeginChild( strId, ImVec2( 0.0f, height ), ImGuiChildFlags_Borders ) )
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin( count, rowHeight );
+            while( clipper.Step() )
+            {
+                for( int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++ )
+                {
+                    ImGui::PushID( row );
+                    drawRow( row, entries[ ( std::size_t )row ] );
+                    ImGui::PopID();
+                    drawn++;
+                }
+            }
+        }
+        ImGui::EndChild();
+        return drawn;
+    }
+} // namespace VirtualList